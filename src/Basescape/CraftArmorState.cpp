@@ -156,7 +156,7 @@ void CraftArmorState::btnOkClick(Action *)
 void CraftArmorState::lstSoldiersClick(Action *action)
 {
 	Soldier *s = _base->getSoldiers()->at(_lstSoldiers->getSelectedRow());
-	if (!(s->getCraft() && s->getCraft()->getStatus() == "STR_OUT"))
+	if (!(s->getCraft() && s->getCraft()->getStatus() == CRAFT_OUT))
 	{
 		if (action->getDetails()->button.button == SDL_BUTTON_LEFT)
 		{
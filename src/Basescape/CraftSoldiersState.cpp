@@ -441,7 +441,7 @@ void CraftSoldiersState::lstSoldiersClick(Action *action)
 			s->setCraft(0);
 			_lstSoldiers->setCellText(row, 2, tr("STR_NONE_UC"));
 		}
-		else if (s->getCraft() && s->getCraft()->getStatus() == "STR_OUT")
+		else if (s->getCraft() && s->getCraft()->getStatus() == CRAFT_OUT)
 		{
 			color = _otherCraftColor;
 		}
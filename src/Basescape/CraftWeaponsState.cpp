@@ -158,9 +158,9 @@ void CraftWeaponsState::lstWeaponsClick(Action *)
 		sel->setRearming(true);
 		_base->getStorageItems()->removeItem(sel->getRules()->getLauncherItem());
 		_base->getCrafts()->at(_craft)->getWeapons()->at(_weapon) = sel;
-		if (_base->getCrafts()->at(_craft)->getStatus() == "STR_READY")
+		if (_base->getCrafts()->at(_craft)->getStatus() == CRAFT_READY)
 		{
-			_base->getCrafts()->at(_craft)->setStatus("STR_REARMING");
+			_base->getCrafts()->at(_craft)->setStatus(CRAFT_REARMING);
 		}
 	}
 
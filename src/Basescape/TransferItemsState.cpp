@@ -154,7 +154,7 @@ TransferItemsState::TransferItemsState(Base *baseFrom, Base *baseTo) : _baseFrom
 	}
 	for (std::vector<Craft*>::iterator i = _baseFrom->getCrafts()->begin(); i != _baseFrom->getCrafts()->end(); ++i)
 	{
-		if ((*i)->getStatus() != "STR_OUT" || (Options::canTransferCraftsWhileAirborne && (*i)->getFuel() >= (*i)->getFuelLimit(_baseTo)))
+		if ((*i)->getStatus() != CRAFT_OUT || (Options::canTransferCraftsWhileAirborne && (*i)->getFuel() >= (*i)->getFuelLimit(_baseTo)))
 		{
 			TransferRow row = { TRANSFER_CRAFT, (*i), (*i)->getName(_game->getLanguage()), (int)(25 * _distance), 1, 0, 0 };
 			_items.push_back(row);
@@ -363,7 +363,7 @@ void TransferItemsState::completeTransfer()
 					if ((*s)->getCraft() == craft)
 					{
 						if ((*s)->isInPsiTraining()) (*s)->setPsiTraining();
-						if (craft->getStatus() == "STR_OUT") _baseTo->getSoldiers()->push_back(*s);
+						if (craft->getStatus() == CRAFT_OUT) _baseTo->getSoldiers()->push_back(*s);
 						else
 						{
 							t = new Transfer(time);
@@ -383,7 +383,7 @@ void TransferItemsState::completeTransfer()
 				{
 					if (*c == craft)
 					{
-						if (craft->getStatus() == "STR_OUT")
+						if (craft->getStatus() == CRAFT_OUT)
 						{
 							bool returning = (craft->getDestination() == (Target*)craft->getBase());
 							_baseTo->getCrafts()->push_back(craft);
@@ -635,7 +635,7 @@ void TransferItemsState::increaseByValue(int change)
 			_pQty += craft->getNumSoldiers();
 			_iQty += craft->getItems()->getTotalSize(_game->getMod());
 			getRow().amount++;
-			if (!Options::canTransferCraftsWhileAirborne || craft->getStatus() != "STR_OUT")
+			if (!Options::canTransferCraftsWhileAirborne || craft->getStatus() != CRAFT_OUT)
 				_total += getRow().cost;
 			break;
 		case TRANSFER_ITEM:
@@ -719,7 +719,7 @@ void TransferItemsState::decreaseByValue(int change)
 		break;
 	}
 	getRow().amount -= change;
-	if (!Options::canTransferCraftsWhileAirborne || 0 == craft || craft->getStatus() != "STR_OUT")
+	if (!Options::canTransferCraftsWhileAirborne || 0 == craft || craft->getStatus() != CRAFT_OUT)
 		_total -= getRow().cost * change;
 	updateItemStrings();
 }
@@ -30,6 +30,7 @@
 #include "Pathfinding.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Logger.h"
+#include "../Engine/Profiler.h"
 #include "../Engine/Game.h"
 #include "../Mod/Armor.h"
 #include "../Mod/Mod.h"
@@ -125,6 +126,7 @@ YAML::Node AIModule::save() const
  */
 void AIModule::think(BattleAction *action)
 {
+	Profiler::Scope profile("AIModule::think");
 	action->type = BA_RETHINK;
 	action->actor = _unit;
 	action->weapon = _unit->getMainHandWeapon(false);
@@ -135,11 +137,12 @@ void AIModule::think(BattleAction *action)
 	_escapeAction->number = action->number;
 	_knownEnemies = countKnownTargets();
 	_visibleEnemies = selectNearestTarget();
+	resetExposure();
 	_spottingEnemies = getSpottingUnits(_unit->getPosition());
 	_melee = _unit->getMeleeWeapon() != 0;
 	_rifle = false;
 	_blaster = false;
-	_reachable = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits());
+	_reachable = findReachable(_unit->getTimeUnits());
 	_wasHitBy.clear();
 
 	if (_unit->getCharging() && _unit->getCharging()->isOut())
@@ -186,18 +189,18 @@ void AIModule::think(BattleAction *action)
 				if (rule->getWaypoints() != 0 || (action->weapon->getAmmoItem() && action->weapon->getAmmoItem()->getRules()->getWaypoints() != 0))
 				{
 					_blaster = true;
-					_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_AIMEDSHOT, action->weapon));
+					_reachableWithAttack = findReachable(_unit->getTimeUnits() - _unit->getActionTUs(BA_AIMEDSHOT, action->weapon));
 				}
 				else
 				{
 					_rifle = true;
-					_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_SNAPSHOT, action->weapon));
+					_reachableWithAttack = findReachable(_unit->getTimeUnits() - _unit->getActionTUs(BA_SNAPSHOT, action->weapon));
 				}
 			}
 			else if (rule->getBattleType() == BT_MELEE)
 			{
 				_melee = true;
-				_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, action->weapon));
+				_reachableWithAttack = findReachable(_unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, action->weapon));
 			}
 		}
 		else
@@ -391,6 +394,30 @@ void AIModule::think(BattleAction *action)
 }
 
 
+/**
+ * Finds the tiles the unit can reach with a number of TUs,
+ * sorted so they can be looked up with isReachable().
+ * @param tuMax The maximum TUs to spend.
+ * @return The sorted list of reachable tile indices.
+ */
+std::vector<int> AIModule::findReachable(int tuMax) const
+{
+	std::vector<int> reachable = _save->getPathfinding()->findReachable(_unit, tuMax);
+	std::sort(reachable.begin(), reachable.end());
+	return reachable;
+}
+
+/**
+ * Checks if a position is in a list of reachable tiles.
+ * @param reachable The sorted list of reachable tile indices.
+ * @param pos The position to check.
+ * @return True if the position is reachable.
+ */
+bool AIModule::isReachable(const std::vector<int> &reachable, const Position &pos) const
+{
+	return std::binary_search(reachable.begin(), reachable.end(), _save->getTileIndex(pos));
+}
+
 /*
  * sets the "was hit" flag to true.
  */
@@ -593,16 +620,14 @@ void AIModule::setupAmbush()
 		Position origin = _save->getTileEngine()->getSightOriginVoxel(_aggroTarget);
 
 		// we'll use node positions for this, as it gives map makers a good degree of control over how the units will use the environment.
-		for (std::vector<Node*>::const_iterator i = _save->getNodes()->begin(); i != _save->getNodes()->end(); ++i)
+		std::vector<Node*> nodes;
+		_save->getNodesNear(_unit->getPosition(), 10, nodes);
+		for (std::vector<Node*>::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
 		{
-			if ((*i)->isDummy())
-			{
-				continue;
-			}
 			Position pos = (*i)->getPosition();
 			Tile *tile = _save->getTile(pos);
 			if (tile == 0 || _save->getTileEngine()->distance(pos, _unit->getPosition()) > 10 || pos.z != _unit->getPosition().z || tile->getDangerous() ||
-				std::find(_reachableWithAttack.begin(), _reachableWithAttack.end(), _save->getTileIndex(pos))  == _reachableWithAttack.end())
+				!isReachable(_reachableWithAttack, pos))
 				continue; // just ignore unreachable tiles
 
 			if (_traceAI)
@@ -890,9 +915,9 @@ void AIModule::setupEscape()
 		}
 		else
 		{
-			spotters = getSpottingUnits(_escapeAction->target);
-			if (std::find(_reachable.begin(), _reachable.end(), _save->getTileIndex(_escapeAction->target))  == _reachable.end())
+			if (!isReachable(_reachable, _escapeAction->target))
 				continue; // just ignore unreachable tiles
+			spotters = getSpottingUnits(_escapeAction->target);
 					
 			if (_spottingEnemies || spotters)
 			{
@@ -993,6 +1018,26 @@ int AIModule::countKnownTargets() const
 	return knownEnemies;
 }
 
+/**
+ * Collects the enemies (xcom only) that could be spotting us along with
+ * their eye level, and forgets the positions checked in the last cycle.
+ * Nobody moves while we're thinking, so each position only needs checking once.
+ */
+void AIModule::resetExposure()
+{
+	_spotters.clear();
+	_exposure.clear();
+	for (std::vector<BattleUnit*>::const_iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
+	{
+		if (validTarget(*i, false, false))
+		{
+			Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(*i);
+			originVoxel.z -= 2;
+			_spotters.push_back(std::make_pair(*i, originVoxel));
+		}
+	}
+}
+
 /*
  * counts how many enemies (xcom only) are spotting any given position.
  * @param pos the Position to check for spotters.
@@ -1000,34 +1045,43 @@ int AIModule::countKnownTargets() const
  */
 int AIModule::getSpottingUnits(const Position& pos) const
 {
+	Tile *tile = _save->getTile(pos);
+	if (tile)
+	{
+		std::map<int, int>::const_iterator cached = _exposure.find(_save->getTileIndex(pos));
+		if (cached != _exposure.end())
+		{
+			return cached->second;
+		}
+	}
 	// if we don't actually occupy the position being checked, we need to do a virtual LOF check.
 	bool checking = pos != _unit->getPosition();
 	int tally = 0;
-	for (std::vector<BattleUnit*>::const_iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
+	for (std::vector<std::pair<BattleUnit*, Position> >::const_iterator i = _spotters.begin(); i != _spotters.end(); ++i)
 	{
-		if (validTarget(*i, false, false))
+		int dist = _save->getTileEngine()->distance(pos, i->first->getPosition());
+		if (dist > 20) continue;
+		Position originVoxel = i->second;
+		Position targetVoxel;
+		if (checking)
 		{
-			int dist = _save->getTileEngine()->distance(pos, (*i)->getPosition());
-			if (dist > 20) continue;
-			Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(*i);
-			originVoxel.z -= 2;
-			Position targetVoxel;
-			if (checking)
+			if (_save->getTileEngine()->canTargetUnit(&originVoxel, tile, &targetVoxel, i->first, _unit))
 			{
-				if (_save->getTileEngine()->canTargetUnit(&originVoxel, _save->getTile(pos), &targetVoxel, *i, _unit))
-				{
-					tally++;
-				}
+				tally++;
 			}
-			else
+		}
+		else
+		{
+			if (_save->getTileEngine()->canTargetUnit(&originVoxel, tile, &targetVoxel, i->first))
 			{
-				if (_save->getTileEngine()->canTargetUnit(&originVoxel, _save->getTile(pos), &targetVoxel, *i))
-				{
-					tally++;
-				}
+				tally++;
 			}
 		}
 	}
+	if (tile)
+	{
+		_exposure[_save->getTileIndex(pos)] = tally;
+	}
 	return tally;
 }
 
@@ -1154,7 +1208,7 @@ bool AIModule::selectPointNearTarget(BattleUnit *target, int maxTUs) const
 				if (x || y) // skip the unit itself
 				{
 					Position checkPath = target->getPosition() + Position (x, y, z);
-					if (_save->getTile(checkPath) == 0 || std::find(_reachable.begin(), _reachable.end(), _save->getTileIndex(checkPath))  == _reachable.end())
+					if (_save->getTile(checkPath) == 0 || !isReachable(_reachable, checkPath))
 						continue;
 					int dir = _save->getTileEngine()->getDirectionTo(checkPath, target->getPosition());
 					bool valid = _save->getTileEngine()->validMeleeRange(checkPath, dir, _unit, target, 0);
@@ -1446,7 +1500,7 @@ bool AIModule::findFirePoint()
 		Position pos = _unit->getPosition() + *i;
 		Tile *tile = _save->getTile(pos);
 		if (tile == 0  ||
-			std::find(_reachableWithAttack.begin(), _reachableWithAttack.end(), _save->getTileIndex(pos))  == _reachableWithAttack.end())
+			!isReachable(_reachableWithAttack, pos))
 			continue;
 		int score = 0;
 		// i should really make a function for this
@@ -2071,7 +2125,7 @@ void AIModule::selectMeleeOrRanged()
 		if (RNG::percent(meleeOdds))
 		{
 			_rifle = false;
-			_reachableWithAttack = _save->getPathfinding()->findReachable(_unit, _unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, meleeWeapon));
+			_reachableWithAttack = findReachable(_unit->getTimeUnits() - _unit->getActionTUs(BA_HIT, meleeWeapon));
 			return;
 		}
 	}
@@ -2092,6 +2146,29 @@ bool AIModule::getNodeOfBestEfficacy(BattleAction *action)
 	int bestScore = 2;
 	Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(_unit);
 	Position targetVoxel;
+	// work out who's worth hitting (or sparing) and where they're looking from up front,
+	// rather than again for every node.
+	std::vector<std::pair<BattleUnit*, Position> > candidates;
+	std::vector<int> points;
+	for (std::vector<BattleUnit*>::const_iterator j = _save->getUnits()->begin(); j != _save->getUnits()->end(); ++j)
+	{
+		if ((*j)->isOut())
+		{
+			continue;
+		}
+		int unitPoints = -2;
+		if ((_unit->getFaction() == FACTION_HOSTILE && (*j)->getFaction() != FACTION_HOSTILE) ||
+			(_unit->getFaction() == FACTION_NEUTRAL && (*j)->getFaction() == FACTION_HOSTILE))
+		{
+			unitPoints = (*j)->getTurnsSinceSpotted() <= _intelligence ? 1 : 0;
+		}
+		// no point tracing lines for units that don't count either way
+		if (unitPoints != 0)
+		{
+			candidates.push_back(std::make_pair(*j, _save->getTileEngine()->getSightOriginVoxel(*j)));
+			points.push_back(unitPoints);
+		}
+	}
 	for (std::vector<Node*>::const_iterator i = _save->getNodes()->begin(); i != _save->getNodes()->end(); ++i)
 	{
 		if ((*i)->isDummy())
@@ -2103,26 +2180,15 @@ bool AIModule::getNodeOfBestEfficacy(BattleAction *action)
 			_save->getTileEngine()->canTargetTile(&originVoxel, _save->getTile((*i)->getPosition()), O_FLOOR, &targetVoxel, _unit))
 		{
 			int nodePoints = 0;
-			for (std::vector<BattleUnit*>::const_iterator j = _save->getUnits()->begin(); j != _save->getUnits()->end(); ++j)
+			for (size_t j = 0; j != candidates.size(); ++j)
 			{
-				dist = _save->getTileEngine()->distance((*i)->getPosition(), (*j)->getPosition());
-				if (!(*j)->isOut() && dist < action->weapon->getRules()->getExplosionRadius())
+				dist = _save->getTileEngine()->distance((*i)->getPosition(), candidates[j].first->getPosition());
+				if (dist < action->weapon->getRules()->getExplosionRadius())
 				{
-					Position targetOriginVoxel = _save->getTileEngine()->getSightOriginVoxel(*j);
-					if (_save->getTileEngine()->canTargetTile(&targetOriginVoxel, _save->getTile((*i)->getPosition()), O_FLOOR, &targetVoxel, *j))
+					Position targetOriginVoxel = candidates[j].second;
+					if (_save->getTileEngine()->canTargetTile(&targetOriginVoxel, _save->getTile((*i)->getPosition()), O_FLOOR, &targetVoxel, candidates[j].first))
 					{
-						if ((_unit->getFaction() == FACTION_HOSTILE && (*j)->getFaction() != FACTION_HOSTILE) ||
-							(_unit->getFaction() == FACTION_NEUTRAL && (*j)->getFaction() == FACTION_HOSTILE))
-						{
-							if ((*j)->getTurnsSinceSpotted() <= _intelligence)
-							{
-								nodePoints++;
-							}
-						}
-						else
-						{
-							nodePoints -= 2;
-						}
+						nodePoints += points[j];
 					}
 				}
 			}
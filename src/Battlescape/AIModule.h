@@ -22,6 +22,7 @@
 #include "Position.h"
 #include "../Savegame/BattleUnit.h"
 #include <vector>
+#include <map>
 
 
 namespace OpenXcom
@@ -53,6 +54,14 @@ private:
 	std::vector<int> _reachable, _reachableWithAttack, _wasHitBy;
 	BattleActionType _reserve;
 	UnitFaction _targetFaction;
+	std::vector<std::pair<BattleUnit*, Position> > _spotters;
+	mutable std::map<int, int> _exposure;
+	/// Collects the enemies that could be spotting us this cycle.
+	void resetExposure();
+	/// Finds the tiles the unit can reach, sorted for lookups.
+	std::vector<int> findReachable(int tuMax) const;
+	/// Checks if a position is in a list of reachable tiles.
+	bool isReachable(const std::vector<int> &reachable, const Position &pos) const;
 public:
 	/// Creates a new AIModule linked to the game and a certain unit.
 	AIModule(SavedBattleGame *save, BattleUnit *unit, Node *node);
@@ -0,0 +1,347 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BattlescapeBenchmark.h"
+#include <vector>
+#include <sstream>
+#include "BattlescapeState.h"
+#include "BattlescapeGame.h"
+#include "TileEngine.h"
+#include "Pathfinding.h"
+#include "Position.h"
+#include "../Engine/Game.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Options.h"
+#include "../Engine/Logger.h"
+#include "../Engine/RNG.h"
+#include "../Engine/Screen.h"
+#include "../Engine/Zoom.h"
+#include "../Geoscape/GeoscapeState.h"
+#include "../Mod/RuleItem.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/BattleUnit.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+	/// Seed every measurement starts from.
+	const uint64_t SEED = 1234567;
+
+	/**
+	 * Gets the units still in play.
+	 * @param battle Pointer to the battle.
+	 * @return List of units.
+	 */
+	std::vector<BattleUnit*> getActiveUnits(SavedBattleGame *battle)
+	{
+		std::vector<BattleUnit*> units;
+		for (std::vector<BattleUnit*>::iterator i = battle->getUnits()->begin(); i != battle->getUnits()->end(); ++i)
+		{
+			if (!(*i)->isOut())
+			{
+				units.push_back(*i);
+			}
+		}
+		return units;
+	}
+
+	/**
+	 * Gets the voxel at the middle of a unit's tile.
+	 * @param unit Pointer to the unit.
+	 * @return Voxel position.
+	 */
+	Position getCenterVoxel(BattleUnit *unit)
+	{
+		Position pos = unit->getPosition();
+		return Position(pos.x * 16 + 8, pos.y * 16 + 8, pos.z * 24 + 12);
+	}
+}
+
+/**
+ * Initializes the benchmark.
+ * @param game Pointer to the core game.
+ */
+BattlescapeBenchmark::BattlescapeBenchmark(Game *game) : _game(game), _battle(0), _report("battlescape")
+{
+}
+
+/**
+ *
+ */
+BattlescapeBenchmark::~BattlescapeBenchmark()
+{
+
+}
+
+/**
+ * Loads the active mods the same way the start screen does,
+ * and then the saved battle on top of them, setting up the
+ * Battlescape the same way loading a game does.
+ * @param filename Filename of the save, relative to the user folder.
+ */
+void BattlescapeBenchmark::load(const std::string &filename)
+{
+	Log(LOG_INFO) << "Loading data...";
+	Options::updateMods();
+	Uint64 start = CrossPlatform::getMicroseconds();
+	_game->loadMods();
+	_report.addTime("Mod::loadAll", CrossPlatform::getMicroseconds() - start);
+	_game->defaultLanguage();
+	Log(LOG_INFO) << "Loading saved game: " << filename;
+	SavedGame *save = new SavedGame();
+	try
+	{
+		start = CrossPlatform::getMicroseconds();
+		save->load(filename, _game->getMod());
+		_report.addTime("SavedGame::load", CrossPlatform::getMicroseconds() - start);
+	}
+	catch (...)
+	{
+		delete save;
+		throw;
+	}
+	_game->setSavedGame(save);
+	_battle = save->getSavedBattle();
+	if (_battle == 0)
+	{
+		throw Exception(filename + " is not a Battlescape save");
+	}
+	_game->setState(new GeoscapeState);
+	_battle->loadMapResources(_game->getMod());
+	BattlescapeState *bs = new BattlescapeState;
+	_game->pushState(bs);
+	_battle->setBattleState(bs);
+}
+
+/**
+ * Recalculates the field of view of every unit.
+ */
+void BattlescapeBenchmark::measureFOV()
+{
+	std::vector<BattleUnit*> units = getActiveUnits(_battle);
+	RNG::setSeed(SEED);
+	for (std::vector<BattleUnit*>::iterator i = units.begin(); i != units.end(); ++i)
+	{
+		Uint64 start = CrossPlatform::getMicroseconds();
+		_battle->getTileEngine()->calculateFOV(*i);
+		_report.addTime("TileEngine::calculateFOV", CrossPlatform::getMicroseconds() - start);
+	}
+}
+
+/**
+ * Traces a line of fire from every unit to every other one.
+ */
+void BattlescapeBenchmark::measureLines()
+{
+	std::vector<BattleUnit*> units = getActiveUnits(_battle);
+	RNG::setSeed(SEED);
+	for (std::vector<BattleUnit*>::iterator i = units.begin(); i != units.end(); ++i)
+	{
+		Position origin = _battle->getTileEngine()->getSightOriginVoxel(*i);
+		Uint64 start = CrossPlatform::getMicroseconds();
+		for (std::vector<BattleUnit*>::iterator j = units.begin(); j != units.end(); ++j)
+		{
+			if (i != j)
+			{
+				_battle->getTileEngine()->calculateLine(origin, getCenterVoxel(*j), false, 0, *i);
+			}
+		}
+		_report.addTime("TileEngine::calculateLine", CrossPlatform::getMicroseconds() - start);
+	}
+}
+
+/**
+ * Finds the reachable area of every unit, and a path
+ * from each of them to a random spot on the map.
+ */
+void BattlescapeBenchmark::measurePathfinding()
+{
+	std::vector<BattleUnit*> units = getActiveUnits(_battle);
+	Pathfinding *pathfinding = _battle->getPathfinding();
+	RNG::setSeed(SEED);
+	for (std::vector<BattleUnit*>::iterator i = units.begin(); i != units.end(); ++i)
+	{
+		Position target(RNG::generate(0, _battle->getMapSizeX() - 1), RNG::generate(0, _battle->getMapSizeY() - 1), (*i)->getPosition().z);
+		Uint64 start = CrossPlatform::getMicroseconds();
+		pathfinding->calculate(*i, target);
+		_report.addTime("Pathfinding::calculate", CrossPlatform::getMicroseconds() - start);
+		pathfinding->abortPath();
+
+		start = CrossPlatform::getMicroseconds();
+		pathfinding->findReachable(*i, (*i)->getBaseStats()->tu);
+		_report.addTime("Pathfinding::findReachable", CrossPlatform::getMicroseconds() - start);
+	}
+}
+
+/**
+ * Lets every unit controlled by the AI decide on its next action,
+ * without actually carrying it out.
+ */
+void BattlescapeBenchmark::measureAI()
+{
+	std::vector<BattleUnit*> units = getActiveUnits(_battle);
+	RNG::setSeed(SEED);
+	for (std::vector<BattleUnit*>::iterator i = units.begin(); i != units.end(); ++i)
+	{
+		if ((*i)->getAIModule() == 0)
+		{
+			continue;
+		}
+		BattleAction action;
+		Uint64 start = CrossPlatform::getMicroseconds();
+		(*i)->think(&action);
+		_report.addTime("AIModule::think", CrossPlatform::getMicroseconds() - start);
+	}
+}
+
+/**
+ * Saves the whole game to a scratch file and deletes it.
+ * The file goes in its own subfolder under a name nothing
+ * else uses yet, so no real save is ever overwritten or removed.
+ */
+void BattlescapeBenchmark::measureSave()
+{
+	const std::string folder = "benchmark/";
+	const std::string path = Options::getMasterUserFolder() + folder;
+	if (!CrossPlatform::folderExists(path) && !CrossPlatform::createFolder(path))
+	{
+		Log(LOG_ERROR) << "Failed to create " << path << ", skipping SavedGame::save";
+		return;
+	}
+	std::string filename;
+	for (int i = 0; filename.empty() || CrossPlatform::fileExists(Options::getMasterUserFolder() + filename); ++i)
+	{
+		std::ostringstream ss;
+		ss << folder << "scratch" << i << ".sav";
+		filename = ss.str();
+	}
+	try
+	{
+		Uint64 start = CrossPlatform::getMicroseconds();
+		_game->getSavedGame()->save(filename);
+		_report.addTime("SavedGame::save", CrossPlatform::getMicroseconds() - start);
+	}
+	catch (...)
+	{
+		CrossPlatform::deleteFile(Options::getMasterUserFolder() + filename);
+		throw;
+	}
+	CrossPlatform::deleteFile(Options::getMasterUserFolder() + filename);
+}
+
+/**
+ * Scales a screen sized surface by every usual factor.
+ * Skipped with OpenGL, since that has no window to draw on.
+ */
+void BattlescapeBenchmark::measureZoom()
+{
+	if (Screen::isOpenGLEnabled())
+	{
+		return;
+	}
+	SDL_Surface *src = SDL_CreateRGBSurface(SDL_SWSURFACE, Screen::ORIGINAL_WIDTH, Screen::ORIGINAL_HEIGHT, 8, 0, 0, 0, 0);
+	if (src == 0)
+	{
+		return;
+	}
+	SDL_LockSurface(src);
+	for (int y = 0; y < src->h; ++y)
+	{
+		Uint8 *row = (Uint8*)src->pixels + y * src->pitch;
+		for (int x = 0; x < src->w; ++x)
+		{
+			row[x] = (Uint8)(x ^ y);
+		}
+	}
+	SDL_UnlockSurface(src);
+	for (int scale = 2; scale <= 4; ++scale)
+	{
+		SDL_Surface *dst = SDL_CreateRGBSurface(SDL_SWSURFACE, src->w * scale, src->h * scale, 8, 0, 0, 0, 0);
+		if (dst == 0)
+		{
+			continue;
+		}
+		Uint64 start = CrossPlatform::getMicroseconds();
+		Zoom::flipWithZoom(src, dst, 0, 0, 0, 0, 0);
+		_report.addTime("Zoom::flipWithZoom", CrossPlatform::getMicroseconds() - start);
+		SDL_FreeSurface(dst);
+	}
+	SDL_FreeSurface(src);
+}
+
+/**
+ * Sets off an explosion on every unit. This changes the battle,
+ * so it has to be measured last.
+ */
+void BattlescapeBenchmark::measureExplosions()
+{
+	std::vector<BattleUnit*> units = getActiveUnits(_battle);
+	RNG::setSeed(SEED);
+	for (std::vector<BattleUnit*>::iterator i = units.begin(); i != units.end(); ++i)
+	{
+		Uint64 start = CrossPlatform::getMicroseconds();
+		_battle->getTileEngine()->explode(getCenterVoxel(*i), 60, DT_HE, 6);
+		_report.addTime("TileEngine::explode", CrossPlatform::getMicroseconds() - start);
+	}
+}
+
+/**
+ * Runs every measurement a number of times. The
+ * explosions are only set off once, at the end.
+ * @param iterations Number of times to repeat the measurements.
+ */
+void BattlescapeBenchmark::run(int iterations)
+{
+	Log(LOG_INFO) << "Running Battlescape measurements " << iterations << " times...";
+	_report.setValue("units", getActiveUnits(_battle).size());
+	_report.setValue("iterations", iterations);
+	for (int i = 0; i < iterations; ++i)
+	{
+		measureFOV();
+		measureLines();
+		measurePathfinding();
+		measureAI();
+		measureZoom();
+		measureSave();
+	}
+	measureExplosions();
+}
+
+/**
+ * Reports the time spent in each measured function, both to
+ * the standard output and the log.
+ */
+void BattlescapeBenchmark::report() const
+{
+	_report.print();
+}
+
+/**
+ * Saves the time spent in each measured function as JSON.
+ * @param filename Full path of the file.
+ */
+void BattlescapeBenchmark::save(const std::string &filename) const
+{
+	_report.save(filename);
+}
+
+}
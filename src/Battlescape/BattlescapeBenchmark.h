@@ -0,0 +1,70 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include "../Engine/BenchmarkReport.h"
+
+namespace OpenXcom
+{
+
+class Game;
+class SavedBattleGame;
+
+/**
+ * Runs the heavier Battlescape routines on a saved battle
+ * without any player interaction and reports how long they take.
+ * Every measurement starts from the same random seed, so runs
+ * on the same save and data are comparable between builds.
+ */
+class BattlescapeBenchmark
+{
+private:
+	Game *_game;
+	SavedBattleGame *_battle;
+	BenchmarkReport _report;
+	/// Measures the field of view of every unit.
+	void measureFOV();
+	/// Measures the lines of fire between units.
+	void measureLines();
+	/// Measures the pathfinding of every unit.
+	void measurePathfinding();
+	/// Measures the AI decisions.
+	void measureAI();
+	/// Measures saving the game.
+	void measureSave();
+	/// Measures the screen scaling.
+	void measureZoom();
+	/// Measures explosions on every unit.
+	void measureExplosions();
+public:
+	/// Creates a benchmark for the game.
+	BattlescapeBenchmark(Game *game);
+	/// Cleans up the benchmark.
+	~BattlescapeBenchmark();
+	/// Loads the game data and the saved battle.
+	void load(const std::string &filename);
+	/// Runs every measurement.
+	void run(int iterations);
+	/// Logs the timings.
+	void report() const;
+	/// Saves the timings.
+	void save(const std::string &filename) const;
+};
+
+}
@@ -19,6 +19,7 @@
 #include <assert.h>
 #include <fstream>
 #include <sstream>
+#include <map>
 #include "BattlescapeGenerator.h"
 #include "TileEngine.h"
 #include "Inventory.h"
@@ -657,7 +658,7 @@ void BattlescapeGenerator::deployXCOM()
 	for (std::vector<Soldier*>::iterator i = _base->getSoldiers()->begin(); i != _base->getSoldiers()->end(); ++i)
 	{
 		if ((_craft != 0 && (*i)->getCraft() == _craft) ||
-			(_craft == 0 && (*i)->getWoundRecovery() == 0 && ((*i)->getCraft() == 0 || (*i)->getCraft()->getStatus() != "STR_OUT")))
+			(_craft == 0 && (*i)->getWoundRecovery() == 0 && ((*i)->getCraft() == 0 || (*i)->getCraft()->getStatus() != CRAFT_OUT)))
 		{
 			BattleUnit *unit = addXCOMUnit(new BattleUnit(*i, _save->getDepth()));
 			if (unit && !_save->getSelectedUnit())
@@ -684,7 +685,8 @@ void BattlescapeGenerator::deployXCOM()
 	if (_craft != 0)
 	{
 		// add items that are in the craft
-		for (std::map<std::string, int>::iterator i = _craft->getItems()->getContents()->begin(); i != _craft->getItems()->getContents()->end(); ++i)
+		std::map<std::string, int> craftItems = _craft->getItems()->getContents();
+		for (std::map<std::string, int>::iterator i = craftItems.begin(); i != craftItems.end(); ++i)
 		{
 			for (int count = 0; count < i->second; count++)
 			{
@@ -698,7 +700,8 @@ void BattlescapeGenerator::deployXCOM()
 		if (_game->getSavedGame()->getMonthsPassed() != -1)
 		{
 			// add items that are in the base
-			for (std::map<std::string, int>::iterator i = _base->getStorageItems()->getContents()->begin(); i != _base->getStorageItems()->getContents()->end();)
+			std::map<std::string, int> baseItems = _base->getStorageItems()->getContents();
+			for (std::map<std::string, int>::iterator i = baseItems.begin(); i != baseItems.end(); ++i)
 			{
 				// only put items in the battlescape that make sense (when the item got a sprite, it's probably ok)
 				RuleItem *rule = _game->getMod()->getItem(i->first, true);
@@ -708,22 +711,17 @@ void BattlescapeGenerator::deployXCOM()
 					{
 						_craftInventoryTile->addItem(new BattleItem(_game->getMod()->getItem(i->first, true), _save->getCurrentItemId()), ground);
 					}
-					std::map<std::string, int>::iterator tmp = i;
-					++i;
-					_base->getStorageItems()->removeItem(tmp->first, tmp->second);
-				}
-				else
-				{
-					++i;
+					_base->getStorageItems()->removeItem(i->first, i->second);
 				}
 			}
 		}
 		// add items from crafts in base
 		for (std::vector<Craft*>::iterator c = _base->getCrafts()->begin(); c != _base->getCrafts()->end(); ++c)
 		{
-			if ((*c)->getStatus() == "STR_OUT")
+			if ((*c)->getStatus() == CRAFT_OUT)
 				continue;
-			for (std::map<std::string, int>::iterator i = (*c)->getItems()->getContents()->begin(); i != (*c)->getItems()->getContents()->end(); ++i)
+			std::map<std::string, int> craftItems = (*c)->getItems()->getContents();
+			for (std::map<std::string, int>::iterator i = craftItems.begin(); i != craftItems.end(); ++i)
 			{
 				for (int count = 0; count < i->second; count++)
 				{
@@ -1981,9 +1979,9 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script)
 	// create an array to track command success/failure
 	std::map<int, bool> conditionals;
 
+	MapDataSet::loadData(*_terrain->getMapDataSets());
 	for (std::vector<MapDataSet*>::iterator i = _terrain->getMapDataSets()->begin(); i != _terrain->getMapDataSets()->end(); ++i)
 	{
-		(*i)->loadData();
 		if (_game->getMod()->getMCDPatch((*i)->getName()))
 		{
 			_game->getMod()->getMCDPatch((*i)->getName())->modifyData(*i);
@@ -2228,9 +2226,9 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script)
 
 	if (!ufoMaps.empty() && ufoTerrain)
 	{
+		MapDataSet::loadData(*ufoTerrain->getMapDataSets());
 		for (std::vector<MapDataSet*>::iterator i = ufoTerrain->getMapDataSets()->begin(); i != ufoTerrain->getMapDataSets()->end(); ++i)
 		{
-			(*i)->loadData();
 			if (_game->getMod()->getMCDPatch((*i)->getName()))
 			{
 				_game->getMod()->getMCDPatch((*i)->getName())->modifyData(*i);
@@ -2255,9 +2253,9 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script)
 
 	if (craftMap)
 	{
+		MapDataSet::loadData(*_craft->getRules()->getBattlescapeTerrainData()->getMapDataSets());
 		for (std::vector<MapDataSet*>::iterator i = _craft->getRules()->getBattlescapeTerrainData()->getMapDataSets()->begin(); i != _craft->getRules()->getBattlescapeTerrainData()->getMapDataSets()->end(); ++i)
 		{
-			(*i)->loadData();
 			if (_game->getMod()->getMCDPatch((*i)->getName()))
 			{
 				_game->getMod()->getMCDPatch((*i)->getName())->modifyData(*i);
@@ -2436,9 +2434,20 @@ void BattlescapeGenerator::loadNodes()
 
 /**
  * Attaches all the nodes together in an intricate web of lies.
+ * Nodes are grouped by segment first, so each link only
+ * has to look at the nodes of the neighbouring segment.
  */
 void BattlescapeGenerator::attachNodeLinks()
 {
+	std::map<int, std::vector<Node*> > segmentNodes;
+	for (std::vector<Node*>::iterator i = _save->getNodes()->begin(); i != _save->getNodes()->end(); ++i)
+	{
+		if (!(*i)->isDummy())
+		{
+			segmentNodes[(*i)->getSegment()].push_back(*i);
+		}
+	}
+
 	for (std::vector<Node*>::iterator i = _save->getNodes()->begin(); i != _save->getNodes()->end(); ++i)
 	{
 		if ((*i)->isDummy())
@@ -2475,21 +2484,19 @@ void BattlescapeGenerator::attachNodeLinks()
 			{
 				if (*j == neighbourDirections[n])
 				{
-					for (std::vector<Node*>::iterator k = _save->getNodes()->begin(); k != _save->getNodes()->end(); ++k)
+					std::map<int, std::vector<Node*> >::iterator neighbours = segmentNodes.find(neighbourSegments[n]);
+					if (neighbours == segmentNodes.end())
 					{
-						if ((*k)->isDummy())
-						{
-							continue;
-						}
-						if ((*k)->getSegment() == neighbourSegments[n])
+						continue;
+					}
+					for (std::vector<Node*>::iterator k = neighbours->second.begin(); k != neighbours->second.end(); ++k)
+					{
+						for (std::vector<int>::iterator l = (*k)->getNodeLinks()->begin(); l != (*k)->getNodeLinks()->end(); ++l )
 						{
-							for (std::vector<int>::iterator l = (*k)->getNodeLinks()->begin(); l != (*k)->getNodeLinks()->end(); ++l )
+							if (*l == neighbourDirectionsInverted[n])
 							{
-								if (*l == neighbourDirectionsInverted[n])
-								{
-									*l = node->getID();
-									*j = (*k)->getID();
-								}
+								*l = node->getID();
+								*j = (*k)->getID();
 							}
 						}
 					}
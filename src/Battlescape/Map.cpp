@@ -34,6 +34,7 @@
 #include "../Engine/Palette.h"
 #include "../Engine/Game.h"
 #include "../Engine/Screen.h"
+#include "../Engine/Profiler.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Savegame/Tile.h"
 #include "../Savegame/BattleUnit.h"
@@ -250,6 +251,7 @@ void Map::setPalette(SDL_Color *colors, int firstcolor, int ncolors)
  */
 void Map::drawTerrain(Surface *surface)
 {
+	Profiler::Scope profile("Map::drawTerrain");
 	int frameNumber = 0;
 	Surface *tmpSurface;
 	Tile *tile;
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <algorithm>
+#include <cstring>
 #include "../fmath.h"
 #include "MiniMapView.h"
 #include "MiniMapState.h"
@@ -48,41 +49,62 @@ const int MAX_FRAME = 2;
  * @param camera The Battlescape camera.
  * @param battleGame Pointer to the SavedBattleGame.
  */
-MiniMapView::MiniMapView(int w, int h, int x, int y, Game * game, Camera * camera, SavedBattleGame * battleGame) : InteractiveSurface(w, h, x, y), _game(game), _camera(camera), _battleGame(battleGame), _frame(0), _isMouseScrolling(false), _isMouseScrolled(false), _xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0), _mouseScrollX(0), _mouseScrollY(0), _totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(false)
+MiniMapView::MiniMapView(int w, int h, int x, int y, Game * game, Camera * camera, SavedBattleGame * battleGame) : InteractiveSurface(w, h, x, y), _game(game), _camera(camera), _battleGame(battleGame), _frame(0), _isMouseScrolling(false), _isMouseScrolled(false), _xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0), _mouseScrollX(0), _mouseScrollY(0), _totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(false), _cacheLevel(-1)
 {
 	_set = _game->getMod()->getSurfaceSet("SCANG.DAT");
+	_cache.resize(MAX_FRAME + 1, 0);
 }
 
 /**
- * Draws the minimap.
+ * Deletes the cached minimap images.
  */
-void MiniMapView::draw()
+MiniMapView::~MiniMapView()
 {
-	int _startX = _camera->getCenterPosition().x - ((getWidth() / CELL_WIDTH) / 2);
-	int _startY = _camera->getCenterPosition().y - ((getHeight() / CELL_HEIGHT) / 2);
+	for (std::vector<Surface*>::iterator i = _cache.begin(); i != _cache.end(); ++i)
+	{
+		delete *i;
+	}
+}
 
-	InteractiveSurface::draw();
-	if (!_set)
+/**
+ * Gets an image of the whole map up to the displayed level
+ * for the current animation frame, rendering it the first
+ * time it's needed. The battle is paused while the minimap
+ * is open, so the images only go stale when the level changes.
+ * @return Pointer to the minimap image.
+ */
+Surface *MiniMapView::getCache()
+{
+	int level = _camera->getCenterPosition().z;
+	if (level != _cacheLevel)
 	{
-		return;
+		for (std::vector<Surface*>::iterator i = _cache.begin(); i != _cache.end(); ++i)
+		{
+			delete *i;
+			*i = 0;
+		}
+		_cacheLevel = level;
 	}
-	drawRect(0, 0, getWidth(), getHeight(), 15);
-	this->lock();
-	for (int lvl = 0; lvl <= _camera->getCenterPosition().z; lvl++)
+	if (_cache[_frame])
 	{
-		int py = _startY;
-		for (int y = Surface::getY(); y < getHeight() + Surface::getY(); y += CELL_HEIGHT)
+		return _cache[_frame];
+	}
+
+	Surface *cache = new Surface(_battleGame->getMapSizeX() * CELL_WIDTH, _battleGame->getMapSizeY() * CELL_HEIGHT);
+	cache->clear(15);
+	cache->lock();
+	for (int lvl = 0; lvl <= level; lvl++)
+	{
+		for (int py = 0; py < _battleGame->getMapSizeY(); py++)
 		{
-			int px = _startX;
-			for (int x = Surface::getX(); x < getWidth() + Surface::getX(); x += CELL_WIDTH)
+			int y = py * CELL_HEIGHT;
+			for (int px = 0; px < _battleGame->getMapSizeX(); px++)
 			{
+				int x = px * CELL_WIDTH;
 				MapData * data = 0;
-				Tile * t = 0;
-				Position p (px, py, lvl);
-				t = _battleGame->getTile(p);
+				Tile * t = _battleGame->getTile(Position(px, py, lvl));
 				if (!t)
 				{
-					px++;
 					continue;
 				}
 				for (int i = 0; i < 4; i++)
@@ -100,7 +122,7 @@ void MiniMapView::draw()
 								shade = t->getShade();
 								if (shade > 7) shade = 7; //vanilla
 							}
-							s->blitNShade(this, x, y, shade);
+							s->blitNShade(cache, x, y, shade);
 						}
 					}
 				}
@@ -113,21 +135,59 @@ void MiniMapView::draw()
 					frame += t->getPosition().x - t->getUnit()->getPosition().x;
 					frame += _frame * size * size;
 					Surface * s = _set->getFrame(frame);
-					s->blitNShade(this, x, y, 0);
+					s->blitNShade(cache, x, y, 0);
 				}
 				// perhaps (at least one) item on this tile?
 				if (t->isDiscovered(2) && !t->getInventory()->empty())
 				{
 					int frame = 9 + _frame;
 					Surface * s = _set->getFrame(frame);
-					s->blitNShade(this, x, y, 0);
+					s->blitNShade(cache, x, y, 0);
 				}
-
-				px++;
 			}
-			py++;
 		}
 	}
+	cache->unlock();
+	_cache[_frame] = cache;
+	return cache;
+}
+
+/**
+ * Draws the minimap.
+ */
+void MiniMapView::draw()
+{
+	int _startX = _camera->getCenterPosition().x - ((getWidth() / CELL_WIDTH) / 2);
+	int _startY = _camera->getCenterPosition().y - ((getHeight() / CELL_HEIGHT) / 2);
+
+	InteractiveSurface::draw();
+	if (!_set)
+	{
+		return;
+	}
+	// scrolling just moves the window over the cached map
+	Surface *cache = getCache();
+	SDL_Surface *src = cache->getSurface();
+	SDL_Surface *dst = getSurface();
+	int srcX = _startX * CELL_WIDTH;
+	int srcY = _startY * CELL_HEIGHT;
+	int begX = std::min(getWidth(), std::max(0, -srcX));
+	int endX = std::max(begX, std::min(getWidth(), cache->getWidth() - srcX));
+	this->lock();
+	cache->lock();
+	for (int y = 0; y < getHeight(); y++)
+	{
+		Uint8 *row = (Uint8*)dst->pixels + y * dst->pitch;
+		if (srcY + y < 0 || srcY + y >= cache->getHeight() || begX == endX)
+		{
+			memset(row, 15, getWidth());
+			continue;
+		}
+		memset(row, 15, begX);
+		memcpy(row + begX, (Uint8*)src->pixels + (srcY + y) * src->pitch + srcX + begX, endX - begX);
+		memset(row + endX, 15, getWidth() - endX);
+	}
+	cache->unlock();
 	this->unlock();
 	int centerX = getWidth() / 2 - 1;
 	int centerY = getHeight() / 2 - 1;
@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <vector>
 #include "../Engine/InteractiveSurface.h"
 #include "Position.h"
 
@@ -47,6 +48,8 @@ class MiniMapView : public InteractiveSurface
 	Uint32 _mouseScrollingStartTime;
 	int _totalMouseMoveX, _totalMouseMoveY;
 	bool _mouseMovedOverThreshold;
+	std::vector<Surface*> _cache;
+	int _cacheLevel;
 	/// Handles pressing on the MiniMap.
 	void mousePress(Action *action, State *state);
 	/// Handles clicking on the MiniMap.
@@ -55,9 +58,13 @@ class MiniMapView : public InteractiveSurface
 	void mouseOver(Action *action, State *state);
 	/// Handles moving the mouse into the MiniMap surface.
 	void mouseIn(Action *action, State *state);
+	/// Gets the whole minimap for the current frame.
+	Surface *getCache();
 public:
 	/// Creates the MiniMapView.
 	MiniMapView(int w, int h, int x, int y, Game * game, Camera * camera, SavedBattleGame * battleGame);
+	/// Cleans up the MiniMapView.
+	~MiniMapView();
 	/// Draws the minimap.
 	void draw();
 	/// Changes the displayed minimap level.
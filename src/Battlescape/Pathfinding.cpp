@@ -25,6 +25,7 @@
 #include "../Mod/Armor.h"
 #include "../Savegame/BattleUnit.h"
 #include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
 #include "BattlescapeGame.h"
 
 namespace OpenXcom
@@ -79,6 +80,7 @@ PathfindingNode *Pathfinding::getNode(Position pos)
  */
 void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleUnit *target, int maxTUCost)
 {
+	Profiler::Scope profile("Pathfinding::calculate");
 	_totalTUCost = 0;
 	_path.clear();
 	// i'm DONE with these out of bounds errors.
@@ -39,6 +39,7 @@
 #include "../Mod/Armor.h"
 #include "Pathfinding.h"
 #include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
 #include "ProjectileFlyBState.h"
 #include "MeleeAttackBState.h"
 #include "../fmath.h"
@@ -53,7 +54,7 @@ const int TileEngine::heightFromCenter[11] = {0,-2,+2,-4,+4,-6,+6,-8,+8,-12,+12}
  * @param save Pointer to SavedBattleGame object.
  * @param voxelData List of voxel data.
  */
-TileEngine::TileEngine(SavedBattleGame *save, std::vector<Uint16> *voxelData) : _save(save), _voxelData(voxelData), _personalLighting(true)
+TileEngine::TileEngine(SavedBattleGame *save, std::vector<Uint16> *voxelData) : _save(save), _voxelData(voxelData), _personalLighting(true), _spottingTarget(-1), _spottingTurn(-1), _spottingSide(-1)
 {
 }
 
@@ -226,6 +227,7 @@ void TileEngine::addLight(Position center, int power, int layer)
  */
 bool TileEngine::calculateFOV(BattleUnit *unit)
 {
+	Profiler::Scope profile("TileEngine::calculateFOV");
 	size_t oldNumVisibleUnits = unit->getUnitsSpottedThisTurn().size();
 	Position center = unit->getPosition();
 	Position test;
@@ -397,11 +399,7 @@ bool TileEngine::visible(BattleUnit *currentUnit, Tile *tile)
 		return false;
 	}
 
-	// aliens can see in the dark, xcom can see at a distance of 9 or less, further if there's enough light.
-	if ((currentUnit->getFaction() == FACTION_PLAYER &&
-		distance(currentUnit->getPosition(), tile->getPosition()) > 9 &&
-		tile->getShade() > MAX_DARKNESS_TO_SEE_UNITS) ||
-		distance(currentUnit->getPosition(), tile->getPosition()) > MAX_VIEW_DISTANCE)
+	if (!withinSight(currentUnit, tile))
 	{
 		return false;
 	}
@@ -756,6 +754,26 @@ bool TileEngine::canTargetTile(Position *originVoxel, Tile *tile, int part, Posi
 	return false;
 }
 
+/**
+ * Checks if a tile is close enough for a unit to see it,
+ * taking into account the lighting.
+ * @param currentUnit The watcher.
+ * @param tile The tile to check for.
+ * @return True if the tile isn't too far or too dark.
+ */
+bool TileEngine::withinSight(BattleUnit *currentUnit, Tile *tile)
+{
+	// aliens can see in the dark, xcom can see at a distance of 9 or less, further if there's enough light.
+	if ((currentUnit->getFaction() == FACTION_PLAYER &&
+		distance(currentUnit->getPosition(), tile->getPosition()) > 9 &&
+		tile->getShade() > MAX_DARKNESS_TO_SEE_UNITS) ||
+		distance(currentUnit->getPosition(), tile->getPosition()) > MAX_VIEW_DISTANCE)
+	{
+		return false;
+	}
+	return true;
+}
+
 /**
  * Calculates line of sight of a soldiers within range of the Position
  * (used when terrain has changed, which can reveal new parts of terrain or units).
@@ -835,6 +853,29 @@ std::vector<std::pair<BattleUnit *, int> > TileEngine::getSpottingUnits(BattleUn
 	// no reaction on civilian turn.
 	if (_save->getSide() != FACTION_NEUTRAL)
 	{
+		// lines of sight only stay the same while everyone else stays put
+		std::vector<int> layout;
+		for (std::vector<BattleUnit*>::const_iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
+		{
+			if (*i != unit)
+			{
+				layout.push_back((*i)->getId());
+				layout.push_back((*i)->getPosition().x);
+				layout.push_back((*i)->getPosition().y);
+				layout.push_back((*i)->getPosition().z);
+				layout.push_back((*i)->getHeight() + (*i)->getFloatHeight());
+				layout.push_back((*i)->getStatus());
+			}
+		}
+		if (unit->getId() != _spottingTarget || _save->getTurn() != _spottingTurn || _save->getSide() != _spottingSide || layout != _spottingLayout)
+		{
+			clearSpottingCache();
+			_spottingTarget = unit->getId();
+			_spottingTurn = _save->getTurn();
+			_spottingSide = _save->getSide();
+			_spottingLayout.swap(layout);
+		}
+
 		for (std::vector<BattleUnit*>::const_iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
 		{
 				// not dead/unconscious
@@ -850,20 +891,14 @@ std::vector<std::pair<BattleUnit *, int> > TileEngine::getSpottingUnits(BattleUn
 				// closer than 20 tiles
 				distanceSq(unit->getPosition(), (*i)->getPosition()) <= MAX_VIEW_DISTANCE_SQR)
 			{
-				BattleAction falseAction;
-				falseAction.type = BA_SNAPSHOT;
-				falseAction.actor = *i;
-				falseAction.target = unit->getPosition();
-				Position originVoxel = getOriginVoxel(falseAction, 0);
-				Position targetVoxel;
 				AIModule *ai = (*i)->getAIModule();
 				bool gotHit = (ai != 0 && ai->getWasHitBy(unit->getId()));
 					// can actually see the target Tile, or we got hit
 				if (((*i)->checkViewSector(unit->getPosition()) || gotHit) &&
-					// can actually target the unit
-					canTargetUnit(&originVoxel, tile, &targetVoxel, *i) &&
-					// can actually see the unit
-					visible(*i, tile))
+					// not too far or too dark
+					withinSight(*i, tile) &&
+					// can actually target and see the unit
+					canSpot(*i, unit))
 				{
 					if ((*i)->getFaction() == FACTION_PLAYER)
 					{
@@ -882,6 +917,53 @@ std::vector<std::pair<BattleUnit *, int> > TileEngine::getSpottingUnits(BattleUn
 	return spotters;
 }
 
+/**
+ * Checks if a spotter can both target and see a unit, reusing
+ * the result from the last time the spotter checked the unit
+ * from the same place, since tracing the lines is expensive.
+ * @param spotter The unit looking.
+ * @param unit The unit being looked for.
+ * @return True if the unit can be spotted.
+ */
+bool TileEngine::canSpot(BattleUnit *spotter, BattleUnit *unit)
+{
+	int spotterHeight = spotter->getHeight() + spotter->getFloatHeight();
+	int targetHeight = unit->getHeight() + unit->getFloatHeight();
+	std::vector<SpottingEntry> &entries = _spottingCache[spotter->getId()];
+	for (std::vector<SpottingEntry>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+	{
+		if (i->spotterPos == spotter->getPosition() && i->targetPos == unit->getPosition() &&
+			i->spotterHeight == spotterHeight && i->targetHeight == targetHeight)
+		{
+			return i->seen;
+		}
+	}
+
+	BattleAction falseAction;
+	falseAction.type = BA_SNAPSHOT;
+	falseAction.actor = spotter;
+	falseAction.target = unit->getPosition();
+	Position originVoxel = getOriginVoxel(falseAction, 0);
+	Position targetVoxel;
+	SpottingEntry entry;
+	entry.spotterPos = spotter->getPosition();
+	entry.targetPos = unit->getPosition();
+	entry.spotterHeight = spotterHeight;
+	entry.targetHeight = targetHeight;
+	entry.seen = canTargetUnit(&originVoxel, unit->getTile(), &targetVoxel, spotter) && visible(spotter, unit->getTile());
+	entries.push_back(entry);
+	return entry.seen;
+}
+
+/**
+ * Forgets all the cached reaction fire lines of sight,
+ * for when the terrain in between might have changed.
+ */
+void TileEngine::clearSpottingCache()
+{
+	_spottingCache.clear();
+}
+
 /**
  * Gets the unit with the highest reaction score from the spotter vector.
  * @param spotters The vector of spotting units.
@@ -1126,6 +1208,7 @@ BattleUnit *TileEngine::hit(Position center, int power, ItemDamageType type, Bat
 	applyGravity(tile);
 	calculateSunShading(); // roofs could have been destroyed
 	calculateTerrainLighting(); // fires could have been started
+	clearSpottingCache(); // so could walls
 	calculateFOV(center / Position(16,16,24));
 	return bu;
 }
@@ -1407,6 +1490,7 @@ void TileEngine::explode(Position center, int power, ItemDamageType type, int ma
 
 	calculateSunShading(); // roofs could have been destroyed
 	calculateTerrainLighting(); // fires could have been started
+	clearSpottingCache(); // so could walls, and smoke spread
 	calculateFOV(center / Position(16,16,24));
 }
 
@@ -2043,6 +2127,11 @@ int TileEngine::unitOpensDoor(BattleUnit *unit, bool rClick, int dir)
 		}
 	}
 
+	if (door != -1)
+	{
+		clearSpottingCache();
+	}
+
 	if (TUCost != 0)
 	{
 		if (_save->getBattleGame()->checkReservedTU(unit, TUCost))
@@ -2122,6 +2211,10 @@ int TileEngine::closeUfoDoors()
 		}
 		doorsclosed += _save->getTiles()[i]->closeUfoDoor();
 	}
+	if (doorsclosed > 0)
+	{
+		clearSpottingCache();
+	}
 
 	return doorsclosed;
 }
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <vector>
+#include <map>
 #include "Position.h"
 #include "../Mod/RuleItem.h"
 #include <SDL.h>
@@ -47,6 +48,22 @@ private:
 	void addLight(Position center, int power, int layer);
 	int blockage(Tile *tile, const int part, ItemDamageType type, int direction = -1, bool checkingFromOrigin = false);
 	bool _personalLighting;
+	/// Line of sight result between a reaction fire spotter and its target.
+	struct SpottingEntry
+	{
+		Position spotterPos, targetPos;
+		int spotterHeight, targetHeight;
+		bool seen;
+	};
+	std::map<int, std::vector<SpottingEntry> > _spottingCache;
+	std::vector<int> _spottingLayout;
+	int _spottingTarget, _spottingTurn, _spottingSide;
+	/// Checks if a tile is close and lit enough for a unit to see it.
+	bool withinSight(BattleUnit *currentUnit, Tile *tile);
+	/// Checks if a spotter has line of sight and fire to a unit.
+	bool canSpot(BattleUnit *spotter, BattleUnit *unit);
+	/// Forgets the lines of sight worked out for reaction fire.
+	void clearSpottingCache();
 public:
 	/// Creates a new TileEngine class.
 	TileEngine(SavedBattleGame *save, std::vector<Uint16> *voxelData);
@@ -18,11 +18,14 @@
  */
 #include "AdlibMusic.h"
 #include <fstream>
+#include <sstream>
+#include <iomanip>
 #include <algorithm>
 #include "Exception.h"
 #include "Options.h"
 #include "Logger.h"
 #include "Game.h"
+#include "CrossPlatform.h"
 #include "Adlib/fmopl.h"
 #include "Adlib/adlplayer.h"
 
@@ -34,12 +37,17 @@ namespace OpenXcom
 int AdlibMusic::delay = 0;
 int AdlibMusic::rate = 0;
 std::map<int, int> AdlibMusic::delayRates;
+const AdlibMusic *AdlibMusic::current = 0;
+const AdlibMusic *AdlibMusic::saving = 0;
+
+/// Longest track that will be kept rendered, in seconds.
+const int MAX_CACHE_LENGTH = 10 * 60;
 
 /**
  * Initializes a new music track.
  * @param volume Music volume modifier (1.0 = 100%).
  */
-AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volume)
+AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volume), _pcmPos(0), _cacheState(CACHE_NONE), _cacheSaved(false), _cacheSaver(0)
 {
 	rate = Options::audioSampleRate;
 	if (!opl[0])
@@ -79,6 +87,12 @@ AdlibMusic::~AdlibMusic()
 		OPLDestroy(opl[1]);
 		opl[1] = 0;
 	}
+	if (current == this)
+	{
+		stop();
+		current = 0;
+	}
+	waitCache();
 	delete[] _data;
 }
 
@@ -124,13 +138,160 @@ void AdlibMusic::play(int) const
 	if (!Options::mute)
 	{
 		stop();
-		func_setup_music((unsigned char*)_data, _size);
-		func_set_music_volume(127 * _volume);
+		if (current && current != this)
+		{
+			current->releaseCache();
+		}
+		current = this;
+		// the samples can't be touched while they're being saved
+		waitCache();
+		if (Options::adlibCache && _cacheState == CACHE_NONE)
+		{
+			if (!loadCache())
+			{
+				// render it while it plays
+				_cacheState = CACHE_CAPTURING;
+				_pcm.clear();
+				_pcm.reserve(rate * 2 * 60);
+			}
+		}
+		if (_cacheState == CACHE_READY)
+		{
+			_pcmPos = 0;
+		}
+		else
+		{
+			if (_cacheState == CACHE_CAPTURING)
+			{
+				_pcm.clear();
+			}
+			func_setup_music((unsigned char*)_data, _size);
+			func_set_music_volume(127 * _volume);
+		}
 		Mix_HookMusic(player, (void*)this);
 	}
 #endif
 }
 
+/**
+ * Gets the file the rendered track is cached in, named after
+ * the track contents and the sample rate it was rendered at.
+ * @return Path to the cache file.
+ */
+std::string AdlibMusic::getCacheFile() const
+{
+	Uint32 hash = 2166136261u;
+	for (size_t i = 0; i < _size; ++i)
+	{
+		hash = (hash ^ (Uint8)_data[i]) * 16777619u;
+	}
+	std::ostringstream ss;
+	ss << Options::getUserFolder() << "cache/adlib_" << std::hex << std::setfill('0') << std::setw(8) << hash << std::dec << "_" << rate << ".pcm";
+	return ss.str();
+}
+
+/**
+ * Loads the rendered track from the cache, if it's been rendered before.
+ * @return True if the track was loaded.
+ */
+bool AdlibMusic::loadCache() const
+{
+	std::ifstream in(getCacheFile().c_str(), std::ios::in | std::ios::binary);
+	if (!in)
+	{
+		return false;
+	}
+	Uint32 samples = 0;
+	in.read((char*)&samples, sizeof(samples));
+	if (!in || samples == 0 || samples > (Uint32)rate * 2 * MAX_CACHE_LENGTH)
+	{
+		return false;
+	}
+	_pcm.resize(samples);
+	in.read((char*)&_pcm[0], samples * sizeof(Sint16));
+	if (!in)
+	{
+		std::vector<Sint16>().swap(_pcm);
+		return false;
+	}
+	_cacheState = CACHE_READY;
+	_cacheSaved = true;
+	return true;
+}
+
+/**
+ * Saves a rendered track to the cache, run in the background
+ * once another track starts playing. The samples are only read
+ * here, they're let go of by waitCache() after the save is done.
+ * @param music_ptr Pointer to the music track.
+ * @return Always zero.
+ */
+int AdlibMusic::saveCache(void *music_ptr)
+{
+	AdlibMusic *music = (AdlibMusic*)music_ptr;
+	std::string folder = Options::getUserFolder() + "cache/";
+	if (CrossPlatform::folderExists(folder) || CrossPlatform::createFolder(folder))
+	{
+		std::ofstream out(music->getCacheFile().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		Uint32 samples = music->_pcm.size();
+		out.write((const char*)&samples, sizeof(samples));
+		out.write((const char*)&music->_pcm[0], samples * sizeof(Sint16));
+		if (!out)
+		{
+			Log(LOG_WARNING) << "Failed to save Adlib music cache " << music->getCacheFile();
+		}
+	}
+	return 0;
+}
+
+/**
+ * Waits for the track to finish saving, if it's being saved,
+ * and lets go of the saved samples.
+ */
+void AdlibMusic::waitCache() const
+{
+	if (_cacheSaver)
+	{
+		SDL_WaitThread(_cacheSaver, 0);
+		_cacheSaver = 0;
+		std::vector<Sint16>().swap(_pcm);
+		_cacheState = CACHE_NONE;
+		_cacheSaved = true;
+	}
+	if (saving == this)
+	{
+		saving = 0;
+	}
+}
+
+/**
+ * Lets go of the rendered track once another track starts playing,
+ * saving it first if it was rendered this time around.
+ * Unfinished renders are thrown away.
+ */
+void AdlibMusic::releaseCache() const
+{
+	if (_cacheState == CACHE_READY && !_cacheSaved && !_cacheSaver)
+	{
+		// only keep one track around for saving at a time
+		if (saving)
+		{
+			saving->waitCache();
+		}
+		_cacheSaver = SDL_CreateThread(saveCache, (void*)this);
+		if (_cacheSaver)
+		{
+			saving = this;
+			return;
+		}
+	}
+	if (_cacheState == CACHE_READY || _cacheState == CACHE_CAPTURING)
+	{
+		std::vector<Sint16>().swap(_pcm);
+		_cacheState = CACHE_NONE;
+	}
+}
+
 /**
  * Custom audio player.
  * @param udata User data to send to the player.
@@ -142,9 +303,40 @@ void AdlibMusic::player(void *udata, Uint8 *stream, int len)
 #ifndef __NO_MUSIC
 	if (Options::musicVolume == 0)
 		return;
+	AdlibMusic *music = (AdlibMusic*)udata;
+	if (music->_cacheState == CACHE_CAPTURING && !func_is_music_playing())
+	{
+		// the whole track is rendered now
+		music->_cacheState = CACHE_READY;
+		music->_pcmPos = Options::musicAlwaysLoop ? 0 : music->_pcm.size();
+	}
+	if (music->_cacheState == CACHE_READY)
+	{
+		float volume = Game::volumeExponent(Options::musicVolume);
+		Sint16 *out = (Sint16*)stream;
+		size_t samples = len / 2;
+		while (samples != 0)
+		{
+			if (music->_pcmPos == music->_pcm.size())
+			{
+				if (!Options::musicAlwaysLoop)
+					return;
+				music->_pcmPos = 0;
+			}
+			size_t n = std::min(samples, music->_pcm.size() - music->_pcmPos);
+			const Sint16 *in = &music->_pcm[music->_pcmPos];
+			for (size_t j = 0; j < n; ++j)
+			{
+				out[j] = (Sint16)(in[j] * volume);
+			}
+			out += n;
+			samples -= n;
+			music->_pcmPos += n;
+		}
+		return;
+	}
 	if (Options::musicAlwaysLoop && !func_is_music_playing())
 	{
-		AdlibMusic *music = (AdlibMusic*)udata;
 		music->play();
 		return;
 	}
@@ -156,8 +348,32 @@ void AdlibMusic::player(void *udata, Uint8 *stream, int len)
 		if (i)
 		{
 			float volume = Game::volumeExponent(Options::musicVolume);
-			YM3812UpdateOne(opl[0], (INT16*)stream, i / 2, 2, volume);
-			YM3812UpdateOne(opl[1], ((INT16*)stream) + 1, i / 2, 2, volume);
+			if (music->_cacheState == CACHE_CAPTURING)
+			{
+				// render at full volume so the cached track can be played at any volume
+				YM3812UpdateOne(opl[0], (INT16*)stream, i / 2, 2, 1.0f);
+				YM3812UpdateOne(opl[1], ((INT16*)stream) + 1, i / 2, 2, 1.0f);
+				Sint16 *samples = (Sint16*)stream;
+				if (music->_pcm.size() + i / 2 > (size_t)rate * 2 * MAX_CACHE_LENGTH)
+				{
+					// probably never ends, don't bother
+					std::vector<Sint16>().swap(music->_pcm);
+					music->_cacheState = CACHE_FAILED;
+				}
+				else
+				{
+					music->_pcm.insert(music->_pcm.end(), samples, samples + i / 2);
+				}
+				for (int j = 0; j < i / 2; ++j)
+				{
+					samples[j] = (Sint16)(samples[j] * volume);
+				}
+			}
+			else
+			{
+				YM3812UpdateOne(opl[0], (INT16*)stream, i / 2, 2, volume);
+				YM3812UpdateOne(opl[1], ((INT16*)stream) + 1, i / 2, 2, volume);
+			}
 			stream += i;
 			delay -= i;
 			len -= i;
@@ -20,7 +20,9 @@
 #include "Music.h"
 #include <map>
 #include <string>
+#include <vector>
 #include <SDL_mixer.h>
+#include <SDL_thread.h>
 
 namespace OpenXcom
 {
@@ -28,15 +30,36 @@ namespace OpenXcom
 /**
  * Container for Adlib music tracks.
  * Uses a custom YM3812 music player passed to SDL_mixer.
+ * Tracks can be kept as rendered audio so they're only
+ * emulated once, see Options::adlibCache.
  */
 class AdlibMusic : public Music
 {
 private:
+	enum CacheState { CACHE_NONE, CACHE_CAPTURING, CACHE_READY, CACHE_FAILED };
 	char *_data;
 	size_t _size;
 	float _volume;
+	// rendered audio, filled in by the player while the track plays
+	mutable std::vector<Sint16> _pcm;
+	mutable size_t _pcmPos;
+	mutable CacheState _cacheState;
+	mutable bool _cacheSaved;
+	mutable SDL_Thread *_cacheSaver;
 	static int delay, rate;
 	static std::map<int, int> delayRates;
+	static const AdlibMusic *current;
+	static const AdlibMusic *saving;
+	/// Gets the cache file for the rendered track.
+	std::string getCacheFile() const;
+	/// Loads the rendered track from the cache.
+	bool loadCache() const;
+	/// Saves the rendered track to the cache.
+	static int saveCache(void *music_ptr);
+	/// Waits for the rendered track to be saved.
+	void waitCache() const;
+	/// Lets go of the rendered track once it's not playing anymore.
+	void releaseCache() const;
 public:
 	/// Creates a blank music track.
 	AdlibMusic(float volume = 1.0f);
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BenchmarkReport.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "Exception.h"
+#include "Logger.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty report.
+ * @param title Name of the benchmark.
+ */
+BenchmarkReport::BenchmarkReport(const std::string &title) : _title(title)
+{
+}
+
+/**
+ *
+ */
+BenchmarkReport::~BenchmarkReport()
+{
+}
+
+/**
+ * Adds the time taken by a single call to a measured function.
+ * Functions are reported in the order they were first measured.
+ * @param name Name of the function.
+ * @param time Time taken in microseconds.
+ */
+void BenchmarkReport::addTime(const std::string &name, Uint64 time)
+{
+	std::vector<Entry>::iterator i = _entries.begin();
+	while (i != _entries.end() && i->name != name)
+	{
+		++i;
+	}
+	if (i == _entries.end())
+	{
+		Entry entry;
+		entry.name = name;
+		entry.calls = 0;
+		entry.total = 0;
+		entry.best = time;
+		entry.worst = time;
+		_entries.push_back(entry);
+		i = _entries.end() - 1;
+	}
+	i->calls++;
+	i->total += time;
+	i->best = std::min(i->best, time);
+	i->worst = std::max(i->worst, time);
+}
+
+/**
+ * Sets an extra value describing the run, like
+ * the number of game days simulated.
+ * @param name Name of the value.
+ * @param value The value.
+ */
+void BenchmarkReport::setValue(const std::string &name, Sint64 value)
+{
+	for (std::vector<std::pair<std::string, Sint64> >::iterator i = _values.begin(); i != _values.end(); ++i)
+	{
+		if (i->first == name)
+		{
+			i->second = value;
+			return;
+		}
+	}
+	_values.push_back(std::make_pair(name, value));
+}
+
+/**
+ * Reports all the timings, both to the standard output and the log.
+ */
+void BenchmarkReport::print() const
+{
+	std::vector<std::string> lines;
+	std::ostringstream ss;
+	ss << _title << ":";
+	for (std::vector<std::pair<std::string, Sint64> >::const_iterator i = _values.begin(); i != _values.end(); ++i)
+	{
+		ss << " " << i->first << "=" << i->second;
+	}
+	lines.push_back(ss.str());
+	for (std::vector<Entry>::const_iterator i = _entries.begin(); i != _entries.end(); ++i)
+	{
+		ss.str("");
+		ss << std::setw(28) << i->name << ": " << std::setw(8) << i->calls << " calls, " << std::setw(8) << i->total / 1000 << " ms total, ";
+		ss << std::fixed << std::setprecision(1) << std::setw(10) << (double)i->total / i->calls << " us per call";
+		ss << " (" << i->best << "-" << i->worst << ")";
+		lines.push_back(ss.str());
+	}
+	for (std::vector<std::string>::const_iterator i = lines.begin(); i != lines.end(); ++i)
+	{
+		Log(LOG_INFO) << *i;
+		std::cout << *i << std::endl;
+	}
+}
+
+/**
+ * Saves all the timings as a JSON object, meant to be
+ * read by scripts tracking performance over time.
+ * All times are in microseconds.
+ * @param filename Full path of the file.
+ */
+void BenchmarkReport::save(const std::string &filename) const
+{
+	std::ofstream out(filename.c_str());
+	if (!out)
+	{
+		throw Exception("Failed to save " + filename);
+	}
+	out << "{\n\t\"benchmark\": \"" << _title << "\",\n";
+	for (std::vector<std::pair<std::string, Sint64> >::const_iterator i = _values.begin(); i != _values.end(); ++i)
+	{
+		out << "\t\"" << i->first << "\": " << i->second << ",\n";
+	}
+	out << "\t\"results\": [";
+	for (std::vector<Entry>::const_iterator i = _entries.begin(); i != _entries.end(); ++i)
+	{
+		out << (i == _entries.begin() ? "\n" : ",\n");
+		out << "\t\t{\"name\": \"" << i->name << "\", \"calls\": " << i->calls << ", \"total\": " << i->total;
+		out << ", \"best\": " << i->best << ", \"worst\": " << i->worst << "}";
+	}
+	out << "\n\t]\n}\n";
+	Log(LOG_INFO) << "Benchmark results saved to " << filename;
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <utility>
+#include <SDL_types.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Collects the timings of a command line benchmark and
+ * reports them to the log, the standard output or a JSON
+ * file, so runs can be compared between builds.
+ */
+class BenchmarkReport
+{
+private:
+	/**
+	 * Timings of every call to one measured function.
+	 */
+	struct Entry
+	{
+		std::string name;
+		int calls;
+		Uint64 total, best, worst;
+	};
+	std::string _title;
+	std::vector<Entry> _entries;
+	std::vector<std::pair<std::string, Sint64> > _values;
+public:
+	/// Creates an empty report.
+	BenchmarkReport(const std::string &title);
+	/// Cleans up the report.
+	~BenchmarkReport();
+	/// Adds the time of a call to a measured function.
+	void addTime(const std::string &name, Uint64 time);
+	/// Sets an extra value to report.
+	void setValue(const std::string &name, Sint64 value);
+	/// Logs the report.
+	void print() const;
+	/// Saves the report as JSON.
+	void save(const std::string &filename) const;
+};
+
+}
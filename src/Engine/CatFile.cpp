@@ -18,36 +18,47 @@
  */
 
 #include "CatFile.h"
+#include <algorithm>
+#include <cstring>
 #include <SDL.h>
 
 namespace OpenXcom
 {
 
 /**
- * Creates a CAT file stream. A CAT file starts with an index of the
+ * Opens a CAT file. A CAT file starts with an index of the
  * offset and size of every file contained within. Each file consists
  * of a filename followed by its contents.
  * @param path Full path to CAT file.
  */
-CatFile::CatFile(const char *path) : std::ifstream(path, std::ios::in | std::ios::binary), _amount(0), _offset(0), _size(0)
+CatFile::CatFile(const char *path) : _file(path), _valid(false), _amount(0), _offset(0), _size(0)
 {
-	// Get amount of files
-	read((char*)&_amount, sizeof(_amount));
+	const Uint8 *data = _file.getData();
+	size_t size = _file.getSize();
 
-	_amount = (unsigned int)SDL_SwapLE32(_amount);
-	_amount /= 2 * sizeof(_amount);
+	// Get amount of files
+	if (size >= sizeof(_amount))
+	{
+		memcpy(&_amount, data, sizeof(_amount));
+		_amount = (unsigned int)SDL_SwapLE32(_amount);
+		_amount /= 2 * sizeof(_amount);
+	}
+	// the index can't be bigger than the file
+	_valid = !!_file && size >= sizeof(_amount) && _amount <= size / (2 * sizeof(_amount));
+	if (!_valid)
+	{
+		_amount = 0;
+	}
 
 	// Get object offsets
-	seekg(0, std::ios::beg);
-
 	_offset = new unsigned int[_amount];
 	_size   = new unsigned int[_amount];
 
 	for (unsigned int i = 0; i < _amount; ++i)
 	{
-		read((char*)&_offset[i], sizeof(*_offset));
+		memcpy(&_offset[i], data + (2 * i) * sizeof(*_offset), sizeof(*_offset));
 		_offset[i] = (unsigned int)SDL_SwapLE32(_offset[i]);
-		read((char*)&_size[i],   sizeof(*_size));
+		memcpy(&_size[i], data + (2 * i + 1) * sizeof(*_size), sizeof(*_size));
 		_size[i] = (unsigned int)SDL_SwapLE32(_size[i]);
 	}
 }
@@ -59,8 +70,6 @@ CatFile::~CatFile()
 {
 	delete[] _offset;
 	delete[] _size;
-
-	close();
 }
 
 /**
@@ -74,15 +83,15 @@ char *CatFile::load(unsigned int i, bool name)
 	if (i >= _amount)
 		return 0;
 
-	seekg(_offset[i], std::ios::beg);
+	size_t offset = std::min((size_t)_offset[i], _file.getSize());
 
-	unsigned char namesize = peek();
+	unsigned char namesize = (offset < _file.getSize()) ? _file.getData()[offset] : 0xFF;
 	// Skip filename (if there's any)
 	if (namesize<=56)
 	{
 		if (!name)
 		{
-			seekg(namesize + 1, std::ios::cur);
+			offset = std::min(offset + namesize + 1, _file.getSize());
 		}
 		else
 		{
@@ -90,9 +99,11 @@ char *CatFile::load(unsigned int i, bool name)
 		}
 	}
 
-	// Read object
+	// Copy object, anything past the end of the file is left blank
 	char *object = new char[_size[i]];
-	read(object, _size[i]);
+	size_t available = std::min((size_t)_size[i], _file.getSize() - offset);
+	memcpy(object, _file.getData() + offset, available);
+	memset(object + available, 0, _size[i] - available);
 
 	return object;
 }
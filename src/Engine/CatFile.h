@@ -17,27 +17,29 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include <fstream>
+#include "MappedFile.h"
 
 namespace OpenXcom
 {
 
 /**
- * Subclass of std::ifstream to handle CAT files
+ * Reader for CAT files, mapped into memory.
  */
-class CatFile : protected std::ifstream
+class CatFile
 {
 private:
+	MappedFile _file;
+	bool _valid;
 	unsigned int _amount, *_offset, *_size;
 public:
-	/// Creates a CAT file stream.
+	/// Opens a CAT file.
 	CatFile(const char *path);
-	/// Cleans up the stream.
+	/// Cleans up the file.
 	~CatFile();
-	/// Inherit operator.
+	/// Checks if the file couldn't be read.
 	bool operator !() const
 	{
-		return std::ifstream::operator!();
+		return !_valid;
 	}
 	/// Get amount of objects.
 	int getAmount() const
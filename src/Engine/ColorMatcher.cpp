@@ -0,0 +1,124 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ColorMatcher.h"
+#include <algorithm>
+#include <climits>
+
+namespace OpenXcom
+{
+
+namespace
+{
+	inline int sqr(int x)
+	{
+		return x * x;
+	}
+
+	/// Distance along one axis from a value to the closest point of a range.
+	inline int nearAxis(int c, int lo, int hi)
+	{
+		return c < lo ? lo - c : (c > hi ? c - hi : 0);
+	}
+
+	/// Distance along one axis from a value to the furthest point of a range.
+	inline int farAxis(int c, int lo, int hi)
+	{
+		return std::max(c - lo, hi - c);
+	}
+}
+
+/**
+ * Builds the lookup grid for a set of colors (only the first 256 are used).
+ * @param colors Pointer to the colors.
+ * @param ncolors Number of colors.
+ */
+ColorMatcher::ColorMatcher(const SDL_Color *colors, int ncolors) : _colors(colors, colors + std::min(std::max(ncolors, 0), 256))
+{
+	const int cellSize = 1 << CELL_BITS;
+	_cells.reserve(GRID_SIZE * GRID_SIZE * GRID_SIZE + 1);
+	std::vector<int> nearest(_colors.size());
+	for (int r = 0; r < GRID_SIZE; ++r)
+	{
+		for (int g = 0; g < GRID_SIZE; ++g)
+		{
+			for (int b = 0; b < GRID_SIZE; ++b)
+			{
+				int rLo = r * cellSize, gLo = g * cellSize, bLo = b * cellSize;
+				int rHi = rLo + cellSize - 1, gHi = gLo + cellSize - 1, bHi = bLo + cellSize - 1;
+				// no color in the cell can be further from its nearest entry
+				// than the smallest worst-case distance to any entry
+				int threshold = INT_MAX;
+				for (size_t i = 0; i < _colors.size(); ++i)
+				{
+					const SDL_Color &c = _colors[i];
+					nearest[i] = sqr(nearAxis(c.r, rLo, rHi)) + sqr(nearAxis(c.g, gLo, gHi)) + sqr(nearAxis(c.b, bLo, bHi));
+					int furthest = sqr(farAxis(c.r, rLo, rHi)) + sqr(farAxis(c.g, gLo, gHi)) + sqr(farAxis(c.b, bLo, bHi));
+					threshold = std::min(threshold, furthest);
+				}
+				_cells.push_back(_candidates.size());
+				for (size_t i = 0; i < _colors.size(); ++i)
+				{
+					if (nearest[i] <= threshold)
+					{
+						_candidates.push_back(i);
+					}
+				}
+			}
+		}
+	}
+	_cells.push_back(_candidates.size());
+}
+
+/**
+ *
+ */
+ColorMatcher::~ColorMatcher()
+{
+}
+
+/**
+ * Gets the entry with the smallest (squared euclidean) distance
+ * to an RGB color. Components are clamped to the 0-255 range.
+ * @param r Red component.
+ * @param g Green component.
+ * @param b Blue component.
+ * @return Index of the closest color.
+ */
+Uint8 ColorMatcher::getNearest(int r, int g, int b) const
+{
+	r = std::min(std::max(r, 0), 255);
+	g = std::min(std::max(g, 0), 255);
+	b = std::min(std::max(b, 0), 255);
+	size_t cell = ((r >> CELL_BITS) * GRID_SIZE + (g >> CELL_BITS)) * GRID_SIZE + (b >> CELL_BITS);
+	Uint8 closest = 0;
+	int lowestDifference = INT_MAX;
+	for (size_t i = _cells[cell]; i < _cells[cell + 1]; ++i)
+	{
+		const SDL_Color &c = _colors[_candidates[i]];
+		int currentDifference = sqr(r - c.r) + sqr(g - c.g) + sqr(b - c.b);
+		if (currentDifference < lowestDifference)
+		{
+			closest = _candidates[i];
+			lowestDifference = currentDifference;
+		}
+	}
+	return closest;
+}
+
+}
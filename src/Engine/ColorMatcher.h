@@ -0,0 +1,50 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <SDL.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Finds the palette entry closest to any RGB color, without
+ * comparing against every single entry. The RGB cube is split
+ * into a grid and each cell only keeps the entries that could
+ * possibly be the nearest to a color inside it, so results are
+ * identical to a brute-force search (ties go to the lowest index).
+ */
+class ColorMatcher
+{
+private:
+	static const int CELL_BITS = 5;
+	static const int GRID_SIZE = 256 >> CELL_BITS;
+	std::vector<SDL_Color> _colors;
+	std::vector<Uint8> _candidates;
+	std::vector<size_t> _cells;
+public:
+	/// Creates a color matcher for a set of colors.
+	ColorMatcher(const SDL_Color *colors, int ncolors);
+	/// Cleans up the color matcher.
+	~ColorMatcher();
+	/// Gets the closest color to an RGB value.
+	Uint8 getNearest(int r, int g, int b) const;
+};
+
+}
@@ -63,6 +63,7 @@
 #include <unistd.h>
 #include <sys/param.h>
 #include <sys/types.h>
+#include <sys/time.h>
 #include <pwd.h>
 #include <execinfo.h>
 #endif
@@ -1097,6 +1098,47 @@ void crashDump(void *ex, const std::string &err)
 	showError(msg.str());
 }
 
+/**
+ * Gets the number of logical processor cores available
+ * in the system, for spreading work across threads.
+ * @return Number of cores, at least 1.
+ */
+int getNumberOfCores()
+{
+	int cores = 1;
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	cores = (int)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+	return cores > 0 ? cores : 1;
+}
+
+/**
+ * Gets a high resolution timestamp for measuring how
+ * long things take, since SDL_GetTicks is too coarse.
+ * @return Microseconds since an unspecified point in time.
+ */
+Uint64 getMicroseconds()
+{
+#ifdef _WIN32
+	LARGE_INTEGER frequency, counter;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+	return (Uint64)(counter.QuadPart / frequency.QuadPart * 1000000 + counter.QuadPart % frequency.QuadPart * 1000000 / frequency.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (Uint64)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+#else
+	struct timeval now;
+	gettimeofday(&now, 0);
+	return (Uint64)now.tv_sec * 1000000 + now.tv_usec;
+#endif
+}
+
 }
 
 }
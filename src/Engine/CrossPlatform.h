@@ -97,6 +97,10 @@ namespace CrossPlatform
 	std::string now();
 	/// Produces a crash dump.
 	void crashDump(void *ex, const std::string &err);
+	/// Gets the number of processor cores.
+	int getNumberOfCores();
+	/// Gets a high resolution timestamp.
+	Uint64 getMicroseconds();
 }
 
 }
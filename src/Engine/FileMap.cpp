@@ -20,18 +20,46 @@
 #include "FileMap.h"
 #include "Logger.h"
 #include "CrossPlatform.h"
+#include "Options.h"
+#include <SDL_types.h>
 #include <map>
 #include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <ctime>
 
 namespace OpenXcom
 {
 namespace FileMap
 {
 
+/// A mapped resource, the key is the canonical relative path.
+struct Resource
+{
+	std::string key, path;
+};
+
+/// A directory listing, as remembered between runs.
+struct CachedFolder
+{
+	time_t modified, scanned;
+	std::vector<std::string> files;
+	std::vector<bool> folders;
+	bool used;
+	CachedFolder() : modified(0), scanned(0), used(false) {}
+};
+
 static std::vector<std::pair<std::string, std::vector<std::string> > > _rulesets;
-static std::map<std::string, std::string> _resources;
+static std::vector<Resource> _resources;
+static std::vector<size_t> _buckets;
 static std::map< std::string, std::set<std::string> > _vdirs;
 static std::set<std::string> _emptySet;
+static std::map<std::string, CachedFolder> _folders;
+static bool _foldersLoaded = false, _foldersChanged = false;
+
+/// Identifies index cache files, bump the version whenever the format changes.
+static const char CacheMagic[4] = { 'O', 'X', 'F', 'M' };
+static const Uint32 CacheVersion = 1;
 
 static std::string _canonicalize(const std::string &in)
 {
@@ -40,16 +68,92 @@ static std::string _canonicalize(const std::string &in)
 	return ret;
 }
 
+/**
+ * Hashes a path (FNV-1a) ignoring case, so lookups
+ * don't need to build a canonical copy first.
+ */
+static size_t _hash(const std::string &path)
+{
+	Uint32 hash = 2166136261u;
+	for (std::string::const_iterator i = path.begin(); i != path.end(); ++i)
+	{
+		hash ^= (Uint8)tolower(*i);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static bool _equalsIgnoreCase(const std::string &canonical, const std::string &path)
+{
+	if (canonical.size() != path.size())
+	{
+		return false;
+	}
+	for (size_t i = 0; i < path.size(); ++i)
+	{
+		if (canonical[i] != tolower(path[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Finds the bucket for a path in the resource index.
+ * @param path Relative path, in any case.
+ * @return Bucket holding the resource, or the empty bucket it belongs in.
+ * Buckets hold the resource index + 1, so 0 marks an empty bucket.
+ */
+static size_t _findBucket(const std::string &path)
+{
+	size_t mask = _buckets.size() - 1;
+	size_t i = _hash(path) & mask;
+	while (_buckets[i] != 0 && !_equalsIgnoreCase(_resources[_buckets[i] - 1].key, path))
+	{
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+/**
+ * Adds a resource to the index, unless it's already there.
+ * @return True if the resource was added.
+ */
+static bool _addResource(const std::string &key, const std::string &path)
+{
+	// keep the table at most half full so probe chains stay short
+	if ((_resources.size() + 1) * 2 > _buckets.size())
+	{
+		_buckets.assign(std::max<size_t>(1024, _buckets.size() * 2), 0);
+		for (size_t i = 0; i < _resources.size(); ++i)
+		{
+			_buckets[_findBucket(_resources[i].key)] = i + 1;
+		}
+	}
+	size_t bucket = _findBucket(key);
+	if (_buckets[bucket] != 0)
+	{
+		return false;
+	}
+	Resource resource;
+	resource.key = key;
+	resource.path = path;
+	_resources.push_back(resource);
+	_buckets[bucket] = _resources.size();
+	return true;
+}
+
 const std::string &getFilePath(const std::string &relativeFilePath)
 {
-	std::string canonicalRelativeFilePath = _canonicalize(relativeFilePath);
-	if (_resources.find(canonicalRelativeFilePath) == _resources.end())
+	size_t resource = _buckets.empty() ? 0 : _buckets[_findBucket(relativeFilePath)];
+	if (resource == 0)
 	{
 		Log(LOG_INFO) << "requested file not found: " << relativeFilePath;
 		return relativeFilePath;
 	}
 
-	return _resources.at(canonicalRelativeFilePath);
+	return _resources[resource - 1].path;
 }
 
 const std::set<std::string> &getVFolderContents(const std::string &relativePath)
@@ -107,12 +211,163 @@ static std::string _combinePath(const std::string &prefixPath, const std::string
 	return ret;
 }
 
+namespace
+{
+	void writeInt(std::ostream &out, Uint32 value)
+	{
+		out.write((const char*)&value, sizeof(value));
+	}
+
+	void writeString(std::ostream &out, const std::string &value)
+	{
+		writeInt(out, value.size());
+		out.write(value.data(), value.size());
+	}
+
+	void writeTime(std::ostream &out, time_t value)
+	{
+		Sint64 time = value;
+		out.write((const char*)&time, sizeof(time));
+	}
+
+	/// Reads values back from a cache buffer, flagging any overrun.
+	struct CacheReader
+	{
+		const char *pos, *end;
+		bool error;
+		CacheReader(const char *begin, const char *end_) : pos(begin), end(end_), error(false) {}
+		bool has(size_t size)
+		{
+			if (error || (size_t)(end - pos) < size)
+			{
+				error = true;
+				return false;
+			}
+			return true;
+		}
+		Uint32 readInt()
+		{
+			Uint32 value = 0;
+			if (has(sizeof(value)))
+			{
+				std::copy(pos, pos + sizeof(value), (char*)&value);
+				pos += sizeof(value);
+			}
+			return value;
+		}
+		time_t readTime()
+		{
+			Sint64 value = 0;
+			if (has(sizeof(value)))
+			{
+				std::copy(pos, pos + sizeof(value), (char*)&value);
+				pos += sizeof(value);
+			}
+			return (time_t)value;
+		}
+		std::string readString()
+		{
+			Uint32 size = readInt();
+			if (!has(size))
+			{
+				return std::string();
+			}
+			std::string value(pos, size);
+			pos += size;
+			return value;
+		}
+	};
+
+	std::string getCachePath()
+	{
+		return Options::getUserFolder() + "cache/filemap.dat";
+	}
+}
+
+/**
+ * Loads the directory listings remembered from the last run.
+ */
+static void _loadFolders()
+{
+	_foldersLoaded = true;
+	std::ifstream in(getCachePath().c_str(), std::ios::in | std::ios::binary);
+	if (!in)
+	{
+		return;
+	}
+	std::vector<char> buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	if (buffer.size() < sizeof(CacheMagic) || !std::equal(CacheMagic, CacheMagic + sizeof(CacheMagic), buffer.begin()))
+	{
+		return;
+	}
+	CacheReader reader(&buffer[0] + sizeof(CacheMagic), &buffer[0] + buffer.size());
+	if (reader.readInt() != CacheVersion)
+	{
+		return;
+	}
+	std::map<std::string, CachedFolder> folders;
+	Uint32 count = reader.readInt();
+	for (Uint32 i = 0; i < count && !reader.error; ++i)
+	{
+		std::string path = reader.readString();
+		CachedFolder &folder = folders[path];
+		folder.modified = reader.readTime();
+		folder.scanned = reader.readTime();
+		Uint32 files = reader.readInt();
+		for (Uint32 j = 0; j < files && !reader.error; ++j)
+		{
+			folder.files.push_back(reader.readString());
+			folder.folders.push_back(reader.has(1) && *reader.pos++ != 0);
+		}
+	}
+	if (reader.error)
+	{
+		Log(LOG_WARNING) << "Discarding corrupt resource index cache: " << getCachePath();
+		return;
+	}
+	_folders.swap(folders);
+}
+
+/**
+ * Gets the contents of a filesystem folder, reusing the listing from
+ * the last run if the folder hasn't been modified since.
+ * @param path Full path to the folder.
+ * @return Folder listing.
+ */
+static const CachedFolder &_getFolder(const std::string &path)
+{
+	if (!_foldersLoaded && Options::fileMapCache)
+	{
+		_loadFolders();
+	}
+	time_t modified = CrossPlatform::getDateModified(path);
+	CachedFolder &folder = _folders[path];
+	// timestamps only have a one second resolution, so don't trust
+	// a listing taken in the same second the folder was changed
+	if (!Options::fileMapCache || modified == 0 || folder.modified != modified || folder.scanned <= modified)
+	{
+		folder.modified = modified;
+		folder.scanned = time(0);
+		folder.files = CrossPlatform::getFolderContents(path);
+		folder.folders.clear();
+		for (std::vector<std::string>::const_iterator i = folder.files.begin(); i != folder.files.end(); ++i)
+		{
+			folder.folders.push_back(CrossPlatform::folderExists(path + "/" + *i));
+		}
+		_foldersChanged = true;
+	}
+	folder.used = true;
+	return folder;
+}
+
 static void _mapFiles(const std::string &modId, const std::string &basePath,
 		      const std::string &relPath, bool ignoreMods)
 {
 	std::string fullDir = basePath + (relPath.length() ? "/" + relPath : "");
-	std::vector<std::string> files = CrossPlatform::getFolderContents(fullDir);
+	const CachedFolder &folder = _getFolder(fullDir);
+	const std::vector<std::string> &files = folder.files;
 	std::set<std::string> rulesetFiles = _filterFiles(files, "rul");
+	std::string canonicalRelativePath = _canonicalize(relPath);
 
 	if (!ignoreMods && rulesetFiles.size())
 	{
@@ -125,8 +380,9 @@ static void _mapFiles(const std::string &modId, const std::string &basePath,
 		}
 	}
 
-	for (std::vector<std::string>::iterator i = files.begin(); i != files.end(); ++i)
+	for (size_t n = 0; n < files.size(); ++n)
 	{
+		const std::string *i = &files[n];
 		std::string fullpath = fullDir + "/" + *i;
 		
 		if (_canonicalize(*i) == "metadata.yml" || rulesetFiles.find(*i) != rulesetFiles.end())
@@ -136,7 +392,7 @@ static void _mapFiles(const std::string &modId, const std::string &basePath,
 			continue;
 		}
 
-		if (CrossPlatform::folderExists(fullpath))
+		if (folder.folders[n])
 		{
 			Log(LOG_VERBOSE) << "  recursing into: " << fullpath;
 			// allow old mod directory format -- if the top-level subdir
@@ -150,7 +406,7 @@ static void _mapFiles(const std::string &modId, const std::string &basePath,
 
 		// populate resource map
 		std::string canonicalRelativeFilePath = _canonicalize(_combinePath(relPath, *i));
-		if (_resources.insert(std::pair<std::string, std::string>(canonicalRelativeFilePath, fullpath)).second)
+		if (_addResource(canonicalRelativeFilePath, fullpath))
 		{
 			Log(LOG_VERBOSE) << "  mapped resource: " << canonicalRelativeFilePath << " -> " << fullpath;
 		}
@@ -160,13 +416,8 @@ static void _mapFiles(const std::string &modId, const std::string &basePath,
 		}
 
 		// populate vdir map
-		std::string canonicalRelativePath = _canonicalize(relPath);
 		std::string canonicalFile = _canonicalize(*i);
-		if (_vdirs.find(canonicalRelativePath) == _vdirs.end())
-		{
-			_vdirs.insert(std::pair< std::string, std::set<std::string> >(canonicalRelativePath, std::set<std::string>()));
-		}
-		if (_vdirs.at(canonicalRelativePath).insert(canonicalFile).second)
+		if (_vdirs[canonicalRelativePath].insert(canonicalFile).second)
 		{
 			Log(LOG_VERBOSE) << "  mapped file to virtual directory: " << canonicalRelativePath << " -> " << canonicalFile;
 		}
@@ -177,7 +428,13 @@ void clear()
 {
 	_rulesets.clear();
 	_resources.clear();
+	_buckets.clear();
 	_vdirs.clear();
+	// start a new mapping pass, so unmapped folders can be forgotten
+	for (std::map<std::string, CachedFolder>::iterator i = _folders.begin(); i != _folders.end(); ++i)
+	{
+		i->second.used = false;
+	}
 }
 
 void load(const std::string &modId, const std::string &path, bool ignoreMods)
@@ -186,6 +443,58 @@ void load(const std::string &modId, const std::string &path, bool ignoreMods)
 	_mapFiles(modId, path, "", ignoreMods);
 }
 
+void save()
+{
+	if (!Options::fileMapCache)
+	{
+		return;
+	}
+	// forget folders that weren't mapped this time (removed or disabled mods)
+	for (std::map<std::string, CachedFolder>::iterator i = _folders.begin(); i != _folders.end();)
+	{
+		if (i->second.used)
+		{
+			++i;
+		}
+		else
+		{
+			_folders.erase(i++);
+			_foldersChanged = true;
+		}
+	}
+	if (!_foldersChanged)
+	{
+		return;
+	}
+	std::string folder = Options::getUserFolder() + "cache/";
+	if (!CrossPlatform::folderExists(folder) && !CrossPlatform::createFolder(folder))
+	{
+		return;
+	}
+	std::ofstream out(getCachePath().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!out)
+	{
+		Log(LOG_WARNING) << "Failed to save resource index cache: " << getCachePath();
+		return;
+	}
+	out.write(CacheMagic, sizeof(CacheMagic));
+	writeInt(out, CacheVersion);
+	writeInt(out, _folders.size());
+	for (std::map<std::string, CachedFolder>::const_iterator i = _folders.begin(); i != _folders.end(); ++i)
+	{
+		writeString(out, i->first);
+		writeTime(out, i->second.modified);
+		writeTime(out, i->second.scanned);
+		writeInt(out, i->second.files.size());
+		for (size_t j = 0; j < i->second.files.size(); ++j)
+		{
+			writeString(out, i->second.files[j]);
+			out.put(i->second.folders[j] ? 1 : 0);
+		}
+	}
+	_foldersChanged = false;
+}
+
 bool isResourcesEmpty(void)
 {
 	return _resources.empty();
@@ -57,6 +57,10 @@ namespace FileMap
 	/// returned by getMods().
 	void load(const std::string &modId, const std::string &path, bool ignoreMods);
 
+	/// Saves the directory listings scanned by load() to the user's cache folder, so the next run only
+	/// has to rescan directories that were modified in the meantime.
+	void save();
+
 	/// Determines if _resources set is empty
 	bool isResourcesEmpty(void);
 }
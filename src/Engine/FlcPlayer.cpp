@@ -78,7 +78,16 @@ enum PlayingState
 	SKIPPED
 };
 
-FlcPlayer::FlcPlayer() : _fileBuf(0), _mainScreen(0), _realScreen(0), _game(0)
+/// How far the cutscene audio can fall behind before the video stops waiting for it, in milliseconds.
+const Uint32 AUDIO_SLACK = 250;
+
+static bool sameColor(const SDL_Color &a, const SDL_Color &b)
+{
+	return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+FlcPlayer::FlcPlayer() : _fileBuf(0), _mainScreen(0), _realScreen(0), _frameHead(0), _framesQueued(0), _decoderDone(false), _decoderQuit(false),
+	_decoder(0), _frameMutex(0), _frameReady(0), _frameFree(0), _paletteShown(false), _startTick(0), _game(0)
 {
 	_volume = Game::volumeExponent(Options::musicVolume);
 }
@@ -118,6 +127,8 @@ bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, b
 	_hasAudio = false;
 	_audioData.loadingBuffer = 0;
 	_audioData.playingBuffer = 0;
+	_audioData.playedSamples = 0;
+	_videoDelay = 0;
 
 	std::ifstream file;
 	file.open(filename, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
@@ -171,6 +182,8 @@ bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, b
 
 void FlcPlayer::deInit()
 {
+	stopDecoder();
+
 	if (_mainScreen != 0 && _realScreen != 0)
 	{
 		if (_mainScreen != _realScreen->getSurface()->getSurface())
@@ -186,7 +199,10 @@ void FlcPlayer::deInit()
 }
 
 /**
- * Starts decoding and playing the FLI/FLC file
+ * Starts decoding and playing the FLI/FLC file.
+ * Frames are decoded ahead on a separate thread, so this
+ * only has to show them when they're due, dropping any
+ * it's fallen too far behind on.
  */
 void FlcPlayer::play(bool skipLastFrame)
 {
@@ -201,20 +217,345 @@ void FlcPlayer::play(bool skipLastFrame)
 	_videoFrameData = _fileBuf + 128;
 	_audioFrameData = _videoFrameData;
 
+	findAudio();
+	startDecoder();
+
+	Uint32 due = 0;
+	bool first = true;
 	while (!shouldQuit())
 	{
 		if (_frameCallBack)
 			(*_frameCallBack)();
-		else // TODO: support both, in the case the callback is not some audio?
-			decodeAudio(2);
 
-		if (!shouldQuit())
-			decodeVideo(skipLastFrame);
+		VideoFrame *frame = waitForFrame();
+		if (frame == 0)
+		{
+			if (!shouldQuit())
+				_playingState = FINISHED;
+			break;
+		}
 
-		if(!shouldQuit())
+		if (first)
+		{
+			_startTick = SDL_GetTicks();
+			first = false;
+		}
+		else
+		{
+			due += getFrameDelay(*frame);
+		}
+
+		while (!shouldQuit() && getPlaybackTime() < due)
+		{
+			SDLPolling();
+			SDL_Delay(1);
+		}
+		if (shouldQuit())
+			break;
+
+		// too slow to show them all, skip ahead to the latest frame that's due
+		VideoFrame *next;
+		while (!frame->last && (next = peekFrame(1)) != 0 && getPlaybackTime() >= due + getFrameDelay(*next))
+		{
+			due += getFrameDelay(*next);
+			releaseFrame();
+			++_frameCount;
+			frame = next;
+		}
+
+		// If this frame is the last one, don't play it
+		if (frame->last)
+			_playingState = FINISHED;
+
+		if (!shouldQuit() || !skipLastFrame)
+			presentFrame(*frame);
+
+		releaseFrame();
+
+		if (!shouldQuit())
 			SDLPolling();
 	}
-	
+
+	stopDecoder();
+}
+
+/**
+ * Looks for the first audio chunk, to set up the
+ * cutscene audio and frame rate before playing.
+ */
+void FlcPlayer::findAudio()
+{
+	Uint8 *pos = _videoFrameData;
+	while (!isEndOfFile(pos))
+	{
+		Uint32 frameSize;
+		Uint16 frameType;
+		if (!isValidFrame(pos, frameSize, frameType) || frameSize == 0)
+			break;
+		if (frameType == AUDIO_CHUNK)
+		{
+			Uint16 sampleRate;
+			readU16(sampleRate, pos + 8);
+			_audioFrameSize = frameSize;
+			_audioData.sampleRate = sampleRate;
+			_videoDelay = 1000 / (_audioData.sampleRate / _audioFrameSize);
+			if (_useInternalAudio)
+			{
+				_hasAudio = true;
+				initAudio(AUDIO_S16SYS, 1);
+			}
+			return;
+		}
+		pos += frameSize;
+	}
+	// no audio to keep time with
+	_videoDelay = _headerSpeed;
+}
+
+/**
+ * Decodes the file up to the next video frame, queueing
+ * up any audio on the way.
+ * @param frame Frame to store the decoded picture in.
+ * @return False if there's no frames left.
+ */
+bool FlcPlayer::decodeNextFrame(VideoFrame &frame)
+{
+	while (!isEndOfFile(_videoFrameData))
+	{
+		if (!isValidFrame(_videoFrameData, _videoFrameSize, _videoFrameType))
+		{
+			return false;
+		}
+
+		switch (_videoFrameType)
+		{
+		case FRAME_TYPE:
+			readU16(_frameChunks, _videoFrameData + 6);
+			readU16(_delayOverride, _videoFrameData + 8);
+
+			// Skip the frame header, we are not interested in the rest
+			_chunkData = _videoFrameData + 16;
+
+			_videoFrameData += _videoFrameSize;
+
+			decodeVideoFrame();
+
+			frame.pixels = _canvas;
+			std::copy(_colors, _colors + 256, frame.colors);
+			frame.delayOverride = _delayOverride;
+			frame.last = isEndOfFile(_videoFrameData);
+			return true;
+		case AUDIO_CHUNK:
+			if (_hasAudio)
+			{
+				Uint16 sampleRate;
+
+				readU16(sampleRate, _videoFrameData + 8);
+
+				_chunkData = _videoFrameData + 16;
+				_audioFrameSize = _videoFrameSize;
+
+				playAudioFrame(sampleRate);
+			}
+			_videoFrameData += _videoFrameSize + 16;
+			break;
+		case PREFIX_CHUNK:
+			// Just skip it
+			_videoFrameData += _videoFrameSize;
+			break;
+		}
+	}
+	return false;
+}
+
+/**
+ * Keeps decoding frames into the queue until the file ends
+ * or the player stops.
+ * @param player Pointer to the player.
+ * @return Always zero.
+ */
+int FlcPlayer::decoderThread(void *player)
+{
+	FlcPlayer *flc = (FlcPlayer*)player;
+	while (true)
+	{
+		SDL_LockMutex(flc->_frameMutex);
+		while (flc->_framesQueued == FRAME_QUEUE_SIZE && !flc->_decoderQuit)
+		{
+			SDL_CondWait(flc->_frameFree, flc->_frameMutex);
+		}
+		if (flc->_decoderQuit)
+		{
+			SDL_UnlockMutex(flc->_frameMutex);
+			break;
+		}
+		// the reader never touches the free slots, so no need to hold the lock while decoding
+		VideoFrame &frame = flc->_frames[(flc->_frameHead + flc->_framesQueued) % FRAME_QUEUE_SIZE];
+		SDL_UnlockMutex(flc->_frameMutex);
+
+		bool decoded = flc->decodeNextFrame(frame);
+
+		SDL_LockMutex(flc->_frameMutex);
+		if (decoded)
+			++flc->_framesQueued;
+		if (!decoded || frame.last)
+			flc->_decoderDone = true;
+		SDL_CondSignal(flc->_frameReady);
+		SDL_UnlockMutex(flc->_frameMutex);
+
+		if (!decoded || frame.last)
+			break;
+	}
+	return 0;
+}
+
+/**
+ * Starts decoding frames in the background. If the thread
+ * can't be started, frames are decoded as they're needed instead.
+ */
+void FlcPlayer::startDecoder()
+{
+	_canvas.assign(_headerWidth * _headerHeight, 0);
+	memset(_colors, 0, sizeof(_colors));
+	_frameHead = 0;
+	_framesQueued = 0;
+	_decoderDone = false;
+	_decoderQuit = false;
+	_paletteShown = false;
+	_frameMutex = SDL_CreateMutex();
+	_frameReady = SDL_CreateCond();
+	_frameFree = SDL_CreateCond();
+	_decoder = SDL_CreateThread(decoderThread, this);
+	if (!_decoder)
+	{
+		Log(LOG_WARNING) << "Failed to start video decoder thread: " << SDL_GetError();
+	}
+}
+
+/**
+ * Stops the decoding thread and cleans up the queue.
+ */
+void FlcPlayer::stopDecoder()
+{
+	if (_decoder)
+	{
+		SDL_LockMutex(_frameMutex);
+		_decoderQuit = true;
+		SDL_CondSignal(_frameFree);
+		SDL_UnlockMutex(_frameMutex);
+		SDL_WaitThread(_decoder, 0);
+		_decoder = 0;
+	}
+	if (_frameMutex)
+	{
+		SDL_DestroyCond(_frameFree);
+		SDL_DestroyCond(_frameReady);
+		SDL_DestroyMutex(_frameMutex);
+		_frameMutex = 0;
+		_frameReady = 0;
+		_frameFree = 0;
+	}
+	_framesQueued = 0;
+}
+
+/**
+ * Waits for the next decoded frame, handling events in the meantime.
+ * @return Pointer to the frame, or NULL if there's none left or the player was skipped.
+ */
+FlcPlayer::VideoFrame *FlcPlayer::waitForFrame()
+{
+	if (!_decoder)
+	{
+		// decode it ourselves
+		if (_framesQueued == 0 && !_decoderDone)
+		{
+			VideoFrame &frame = _frames[_frameHead];
+			if (decodeNextFrame(frame))
+				_framesQueued = 1;
+			if (_framesQueued == 0 || frame.last)
+				_decoderDone = true;
+		}
+		return _framesQueued > 0 ? &_frames[_frameHead] : 0;
+	}
+	SDL_LockMutex(_frameMutex);
+	while (_framesQueued == 0 && !_decoderDone && !shouldQuit())
+	{
+		SDL_CondWaitTimeout(_frameReady, _frameMutex, 10);
+		SDL_UnlockMutex(_frameMutex);
+		SDLPolling();
+		SDL_LockMutex(_frameMutex);
+	}
+	VideoFrame *frame = (_framesQueued > 0 && !shouldQuit()) ? &_frames[_frameHead] : 0;
+	SDL_UnlockMutex(_frameMutex);
+	return frame;
+}
+
+/**
+ * Gets a decoded frame further down the queue, if it's ready already.
+ * @param ahead How many frames after the current one.
+ * @return Pointer to the frame, or NULL if it's not decoded yet.
+ */
+FlcPlayer::VideoFrame *FlcPlayer::peekFrame(int ahead)
+{
+	if (_frameMutex)
+		SDL_LockMutex(_frameMutex);
+	VideoFrame *frame = (_framesQueued > ahead) ? &_frames[(_frameHead + ahead) % FRAME_QUEUE_SIZE] : 0;
+	if (_frameMutex)
+		SDL_UnlockMutex(_frameMutex);
+	return frame;
+}
+
+/**
+ * Hands the current frame's slot back to the decoder.
+ */
+void FlcPlayer::releaseFrame()
+{
+	if (_frameMutex)
+		SDL_LockMutex(_frameMutex);
+	if (_framesQueued > 0)
+	{
+		_frameHead = (_frameHead + 1) % FRAME_QUEUE_SIZE;
+		--_framesQueued;
+	}
+	if (_frameMutex)
+	{
+		SDL_CondSignal(_frameFree);
+		SDL_UnlockMutex(_frameMutex);
+	}
+}
+
+/**
+ * Gets how long to show the previous frame before this one.
+ * Worked out when the frame is shown, since the speed
+ * can be changed while playing.
+ * @param frame The frame.
+ * @return Delay in milliseconds.
+ */
+Uint32 FlcPlayer::getFrameDelay(const VideoFrame &frame)
+{
+	if (_headerType == FLI_TYPE)
+	{
+		return frame.delayOverride > 0 ? frame.delayOverride : _headerSpeed * (1000.0 / 70.0);
+	}
+	return _videoDelay;
+}
+
+/**
+ * Gets how far into the video playback is. Follows the audio
+ * when there is some, so the picture stays in sync with it,
+ * but doesn't wait for it if it's stalled or finished.
+ * @return Playback time in milliseconds.
+ */
+Uint32 FlcPlayer::getPlaybackTime()
+{
+	Uint32 wall = SDL_GetTicks() - _startTick;
+	if (!_hasAudio || _audioData.sampleRate <= 0)
+		return wall;
+	SDL_LockAudio();
+	Uint32 played = _audioData.playedSamples;
+	SDL_UnlockAudio();
+	Uint32 audio = (Uint32)((Uint64)played * 1000 / _audioData.sampleRate);
+	return std::max(audio, wall > AUDIO_SLACK ? wall - AUDIO_SLACK : 0);
 }
 
 void FlcPlayer::delay(Uint32 milliseconds)
@@ -284,106 +625,11 @@ bool FlcPlayer::isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &fram
 	return (frameType == FRAME_TYPE || frameType == AUDIO_CHUNK || frameType == PREFIX_CHUNK);
 }
 
-void FlcPlayer::decodeAudio(int frames)
-{
-
-	int audioFramesFound = 0;
-
-	while (audioFramesFound < frames && !isEndOfFile(_audioFrameData))
-	{
-		if (!isValidFrame(_audioFrameData, _audioFrameSize, _audioFrameType))
-		{
-			_playingState = FINISHED;
-			break;
-		}
-
-		switch (_audioFrameType)
-		{
-			case FRAME_TYPE:
-			case PREFIX_CHUNK:
-				_audioFrameData += _audioFrameSize;
-				break;
-			case AUDIO_CHUNK:
-				Uint16 sampleRate;
-
-				readU16(sampleRate, _audioFrameData + 8);
-
-				_chunkData = _audioFrameData + 16;
-
-				playAudioFrame(sampleRate);
-
-				_audioFrameData += _audioFrameSize + 16;
-
-				++audioFramesFound;
-
-				break;
-		}
-	}
-}
-
-void FlcPlayer::decodeVideo(bool skipLastFrame)
-{
-	bool videoFrameFound = false;
-	
-	while (!videoFrameFound)
-	{
-		if (!isValidFrame(_videoFrameData, _videoFrameSize, _videoFrameType))
-		{
-			_playingState = FINISHED;
-			break;
-		}
-
-		switch (_videoFrameType)
-		{
-		case FRAME_TYPE:
-
-			Uint32 delay;
-
-			readU16(_frameChunks, _videoFrameData + 6);
-			readU16(_delayOverride, _videoFrameData + 8);
-
-			if (_headerType == FLI_TYPE)
-			{
-				delay = _delayOverride > 0 ? _delayOverride : _headerSpeed * (1000.0 / 70.0);
-			}
-			else
-			{
-				delay = _videoDelay;
-			}
-
-			waitForNextFrame(delay);
-
-			// Skip the frame header, we are not interested in the rest
-			_chunkData = _videoFrameData + 16;
-
-			_videoFrameData += _videoFrameSize;
-			// If this frame is the last one, don't play it
-			if(isEndOfFile(_videoFrameData))
-				_playingState = FINISHED;
-
-			if(!shouldQuit() || !skipLastFrame)
-				playVideoFrame();
-
-			videoFrameFound = true;
-
-			break;
-		case AUDIO_CHUNK:
-			_videoFrameData += _videoFrameSize + 16;
-			break;
-		case PREFIX_CHUNK:
-			// Just skip it
-			_videoFrameData += _videoFrameSize;
-
-			break;
-		}
-	}
-}
-
-void FlcPlayer::playVideoFrame()
+/**
+ * Decodes the chunks of the current video frame onto the canvas.
+ */
+void FlcPlayer::decodeVideoFrame()
 {
-	++_frameCount;
-	if (SDL_LockSurface(_mainScreen) < 0)
-		return;
 	int chunkCount = _frameChunks;
 
 	for (int i = 0; i < chunkCount; ++i)
@@ -423,7 +669,34 @@ void FlcPlayer::playVideoFrame()
 
 		_chunkData += _chunkSize;
 	}
+}
 
+/**
+ * Shows a decoded frame on the screen.
+ * @param frame The frame.
+ */
+void FlcPlayer::presentFrame(const VideoFrame &frame)
+{
+	++_frameCount;
+	if (!_paletteShown || !std::equal(frame.colors, frame.colors + 256, _shownColors, sameColor))
+	{
+		std::copy(frame.colors, frame.colors + 256, _shownColors);
+		_paletteShown = true;
+		if (_mainScreen != _realScreen->getSurface()->getSurface())
+			SDL_SetColors(_mainScreen, _shownColors, 0, 256);
+		_realScreen->setPalette(_shownColors, 0, 256, true);
+	}
+
+	if (SDL_LockSurface(_mainScreen) < 0)
+		return;
+	const Uint8 *pSrc = &frame.pixels[0];
+	Uint8 *pDst = (Uint8*)_mainScreen->pixels + _offset;
+	for (int y = 0; y < _headerHeight; ++y)
+	{
+		memcpy(pDst, pSrc, _headerWidth);
+		pSrc += _headerWidth;
+		pDst += _mainScreen->pitch;
+	}
 	SDL_UnlockSurface(_mainScreen);
 
 	/* TODO: Track which rectangles have really changed */
@@ -446,17 +719,8 @@ void FlcPlayer::playAudioFrame(Uint16 sampleRate)
 
 	if (_useInternalAudio)
 	{
-		if (!_hasAudio)
-		{
-			_audioData.sampleRate = sampleRate;
-			_hasAudio = true;
-			initAudio(AUDIO_S16SYS, 1);
-		}
-		else
-		{
-			/* Cannot change sample rate mid-video */
-			assert(sampleRate == _audioData.sampleRate);
-		}
+		/* Cannot change sample rate mid-video */
+		assert(sampleRate == _audioData.sampleRate);
 
 		SDL_SemWait(_audioData.sharedLock);
 		AudioBuffer *loadingBuff = _audioData.loadingBuffer;
@@ -506,15 +770,12 @@ void FlcPlayer::color256()
 
 		for (int i = 0; i < numColors; ++i)
 		{
-			_colors[i].r = *(pSrc++);
-			_colors[i].g = *(pSrc++);
-			_colors[i].b = *(pSrc++);
+			SDL_Color &color = _colors[(numColorsSkip + i) & 0xFF];
+			color.r = *(pSrc++);
+			color.g = *(pSrc++);
+			color.b = *(pSrc++);
 		}
 
-		if (_mainScreen != _realScreen->getSurface()->getSurface())
-			SDL_SetColors(_mainScreen, _colors, numColorsSkip, numColors);
-		_realScreen->setPalette(_colors, numColorsSkip, numColors, true);
-
 		if (numColorPackets >= 1)
 		{
 			++numColors;
@@ -533,7 +794,7 @@ void FlcPlayer::fliSS2()
 	Uint8 lastByte = 0;
 
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 	readU16(lines, pSrc);
 
 	pSrc += 2;
@@ -545,7 +806,7 @@ void FlcPlayer::fliSS2()
 
 		if ((count & MASK) == SKIP_LINES) 
 		{
-			pDst += (-count)*_mainScreen->pitch;
+			pDst += (-count)*_headerWidth;
 			++lines;
 			continue;
 		}
@@ -594,9 +855,9 @@ void FlcPlayer::fliSS2()
 			if (setLastByte)
 			{
 				setLastByte = false;
-				*(pDst + _mainScreen->pitch - 1) = lastByte;
+				*(pDst + _headerWidth - 1) = lastByte;
 			}
-			pDst += _mainScreen->pitch;
+			pDst += _headerWidth;
 		}
 	}
 }
@@ -609,7 +870,7 @@ void FlcPlayer::fliBRun()
 
 	heightCount = _headerHeight;
 	pSrc = _chunkData + 6; // Skip chunk header
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 
 	while (heightCount--) 
 	{
@@ -641,7 +902,7 @@ void FlcPlayer::fliBRun()
 				}
 			}
 		}
-		pDst += _mainScreen->pitch;
+		pDst += _headerWidth;
 	}
 }
 
@@ -656,11 +917,11 @@ void FlcPlayer::fliLC()
 	int packetsCount;
 
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 
 	readU16(tmp, pSrc);
 	pSrc += 2;
-	pDst += tmp*_mainScreen->pitch;
+	pDst += tmp*_headerWidth;
 	readU16(lines, pSrc);
 	pSrc += 2;
 
@@ -695,7 +956,7 @@ void FlcPlayer::fliLC()
 				}
 			}
 		}
-		pDst += _mainScreen->pitch;
+		pDst += _headerWidth;
 	}
 }
 
@@ -721,14 +982,11 @@ void FlcPlayer::color64()
 
 		for (int i = 0; i < NumColors; ++i)
 		{
-			_colors[i].r = *(pSrc++) << 2;
-			_colors[i].g = *(pSrc++) << 2;
-			_colors[i].b = *(pSrc++) << 2;
+			SDL_Color &color = _colors[(NumColorsSkip + i) & 0xFF];
+			color.r = *(pSrc++) << 2;
+			color.g = *(pSrc++) << 2;
+			color.b = *(pSrc++) << 2;
 		}
-
-		if (_mainScreen != _realScreen->getSurface()->getSurface())
-			SDL_SetColors(_mainScreen, _colors, NumColorsSkip, NumColors);
-		_realScreen->setPalette(_colors, NumColorsSkip, NumColors, true);
 	}
 }
 
@@ -737,13 +995,13 @@ void FlcPlayer::fliCopy()
 	Uint8 *pSrc, *pDst;
 	int Lines = _screenHeight;
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 
 	while (Lines--) 
 	{
 		memcpy(pDst, pSrc, _screenWidth);
 		pSrc += _screenWidth;
-		pDst += _mainScreen->pitch;
+		pDst += _headerWidth;
 	}
 }
 
@@ -751,12 +1009,12 @@ void FlcPlayer::black()
 {
 	Uint8 *pDst;
 	int Lines = _screenHeight;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = &_canvas[0];
 
 	while (Lines-- > 0) 
 	{
-		memset(pDst, 0, _screenHeight);
-		pDst += _mainScreen->pitch;
+		memset(pDst, 0, _screenWidth);
+		pDst += _headerWidth;
 	}
 }
 
@@ -773,6 +1031,8 @@ void FlcPlayer::audioCallback(void *userData, Uint8 *stream, int len)
 			int bytesToCopy = std::min(len, playBuff->sampleCount * 2);
 			memcpy(stream, playBuff->samples + playBuff->currSamplePos, bytesToCopy);
 
+			stream += bytesToCopy;
+			audio->playedSamples += bytesToCopy / 2;
 			playBuff->currSamplePos += bytesToCopy / 2;
 			playBuff->sampleCount -= bytesToCopy / 2;
 			len -= bytesToCopy;
@@ -798,7 +1058,6 @@ void FlcPlayer::audioCallback(void *userData, Uint8 *stream, int len)
 
 void FlcPlayer::initAudio(Uint16 format, Uint8 channels)
 {
-	_videoDelay = 1000 / (_audioData.sampleRate / _audioFrameSize );
 	if (_useInternalAudio)
 	{
 		int err;
@@ -883,45 +1142,6 @@ bool FlcPlayer::wasSkipped()
 	return _playingState == SKIPPED;
 }
 
-void FlcPlayer::waitForNextFrame(Uint32 delay)
-{
-	static Uint32 oldTick = 0;
-	int newTick;
-	int currentTick;
-
-	currentTick = SDL_GetTicks();
-	if (oldTick == 0)
-	{
-		oldTick = currentTick;
-		newTick = oldTick;
-	}
-	else
-		newTick = oldTick + delay;
-
-	if (_hasAudio)
-	{
-		while (currentTick < newTick)
-		{
-			while ((newTick - currentTick) > 10 && !isEndOfFile(_audioFrameData))
-			{
-				decodeAudio(1);
-				currentTick = SDL_GetTicks();
-			}
-			SDL_Delay(1);
-			currentTick = SDL_GetTicks();
-		}
-	}
-	else
-	{
-		while (currentTick < newTick)
-		{
-			SDL_Delay(1);
-			currentTick = SDL_GetTicks();
-		}
-	}
-	oldTick = SDL_GetTicks();
-}
-
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
 inline void FlcPlayer::readU16(Uint16 &dst, const Uint8 * const src)
 {
@@ -22,7 +22,9 @@
 /*
  * Based on http://www.libsdl.org/projects/flxplay/
  */
+#include <vector>
 #include <SDL.h>
+#include <SDL_thread.h>
 
 namespace OpenXcom
 {
@@ -86,11 +88,33 @@ private:
 		AudioBuffer *loadingBuffer;
 		AudioBuffer *playingBuffer;
 		SDL_sem *sharedLock;
+		Uint32 playedSamples;
 		
 	}AudioData;
 
 	AudioData _audioData;
 
+	/// A fully decoded video frame waiting to be shown.
+	typedef struct VideoFrame
+	{
+		std::vector<Uint8> pixels;
+		SDL_Color colors[256];
+		Uint16 delayOverride;
+		bool last;
+	}VideoFrame;
+
+	static const int FRAME_QUEUE_SIZE = 8;
+	VideoFrame _frames[FRAME_QUEUE_SIZE];
+	int _frameHead, _framesQueued;
+	bool _decoderDone, _decoderQuit;
+	SDL_Thread *_decoder;
+	SDL_mutex *_frameMutex;
+	SDL_cond *_frameReady, *_frameFree;
+	std::vector<Uint8> _canvas;
+	SDL_Color _shownColors[256];
+	bool _paletteShown;
+	Uint32 _startTick;
+
 	Game *_game;
 
 	void readU16(Uint16 &dst, const Uint8 *const src);
@@ -100,13 +124,21 @@ private:
 	void readFileHeader();
 
 	bool isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &frameType);
-	void decodeVideo(bool skipLastFrame);
-	void decodeAudio(int frames);
-	void waitForNextFrame(Uint32 delay);
+	void findAudio();
+	bool decodeNextFrame(VideoFrame &frame);
+	static int decoderThread(void *player);
+	void startDecoder();
+	void stopDecoder();
+	VideoFrame *waitForFrame();
+	VideoFrame *peekFrame(int ahead);
+	void releaseFrame();
+	Uint32 getFrameDelay(const VideoFrame &frame);
+	Uint32 getPlaybackTime();
 	void SDLPolling();
 	bool shouldQuit();
 
-	void playVideoFrame();
+	void decodeVideoFrame();
+	void presentFrame(const VideoFrame &frame);
 	void color256();
 	void fliBRun();
 	void fliCopy();
@@ -29,7 +29,9 @@
 #include "Logger.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/FpsCounter.h"
+#include "../Interface/ProfilerOverlay.h"
 #include "../Mod/Mod.h"
+#include "../Mod/RulesetCache.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "Action.h"
@@ -37,6 +39,7 @@
 #include "Options.h"
 #include "CrossPlatform.h"
 #include "FileMap.h"
+#include "Profiler.h"
 #include "../Menu/TestState.h"
 
 namespace OpenXcom
@@ -98,6 +101,10 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	// Create fps counter
 	_fpsCounter = new FpsCounter(15, 5, 0, 0);
 
+	// Create profiler overlay
+	Profiler::init();
+	_profilerOverlay = new ProfilerOverlay(160, 140, 0, 6);
+
 	// Create blank language
 	_lang = new Language();
 
@@ -125,6 +132,12 @@ Game::~Game()
 	delete _mod;
 	delete _screen;
 	delete _fpsCounter;
+	delete _profilerOverlay;
+
+	if (Options::rulesetCache)
+	{
+		RulesetCache::prune();
+	}
 
 	Mix_CloseAudio();
 
@@ -251,6 +264,24 @@ void Game::run()
 								Options::debugUi = !Options::debugUi;
 								_states.back()->redrawText();
 							}
+							// "ctrl-p" profiler overlay, "ctrl-shift-p" profiler trace
+							else if (action.getDetails()->key.keysym.sym == SDLK_p && (SDL_GetModState() & KMOD_CTRL) != 0)
+							{
+								if ((SDL_GetModState() & KMOD_SHIFT) == 0)
+								{
+									Options::profiler = !Options::profiler;
+									_profilerOverlay->setVisible(Options::profiler);
+									_profilerOverlay->update();
+								}
+								else if (Profiler::isTracing())
+								{
+									Profiler::stopTrace(Options::getUserFolder() + "trace.json");
+								}
+								else
+								{
+									Profiler::startTrace();
+								}
+							}
 						}
 					}
 					_states.back()->handle(&action);
@@ -262,8 +293,12 @@ void Game::run()
 		if (runningState != PAUSED)
 		{
 			// Process logic
-			_states.back()->think();
+			{
+				Profiler::Scope profile("State::think");
+				_states.back()->think();
+			}
 			_fpsCounter->think();
+			_profilerOverlay->think();
 			if (Options::FPS > 0 && !(Options::useOpenGL && Options::vSyncForOpenGL))
 			{
 				// Update our FPS delay time based on the time of the last draw.
@@ -281,6 +316,7 @@ void Game::run()
 				// make a note of when this frame update occurred.
 				_timeOfLastFrame = SDL_GetTicks();
 				_fpsCounter->addFrame();
+				Profiler::beginFrame();
 				_screen->clear();
 				std::list<State*>::iterator i = _states.end();
 				do
@@ -289,12 +325,17 @@ void Game::run()
 				}
 				while (i != _states.begin() && !(*i)->isScreen());
 
-				for (; i != _states.end(); ++i)
 				{
-					(*i)->blit();
+					Profiler::Scope profile("State::blit");
+					for (; i != _states.end(); ++i)
+					{
+						(*i)->blit();
+					}
 				}
 				_fpsCounter->blit(_screen->getSurface());
+				_profilerOverlay->blit(_screen->getSurface());
 				_cursor->blit(_screen->getSurface());
+				Profiler::Scope profile("Screen::flip");
 				_screen->flip();
 			}
 		}
@@ -310,6 +351,10 @@ void Game::run()
 		}
 	}
 
+	if (Profiler::isTracing())
+	{
+		Profiler::stopTrace(Options::getUserFolder() + "trace.json");
+	}
 	Options::save();
 }
 
@@ -398,6 +443,15 @@ FpsCounter *Game::getFpsCounter() const
 	return _fpsCounter;
 }
 
+/**
+ * Returns the ProfilerOverlay used by the game.
+ * @return Pointer to the ProfilerOverlay.
+ */
+ProfilerOverlay *Game::getProfilerOverlay() const
+{
+	return _profilerOverlay;
+}
+
 /**
  * Pops all the states currently in stack and pushes in the new state.
  * A shortcut for cleaning up all the old states when they're not necessary
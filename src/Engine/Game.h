@@ -31,6 +31,7 @@ class Language;
 class SavedGame;
 class Mod;
 class FpsCounter;
+class ProfilerOverlay;
 
 /**
  * The core of the game engine, manages the game's entire contents and structure.
@@ -50,6 +51,7 @@ private:
 	Mod *_mod;
 	bool _quit, _init;
 	FpsCounter *_fpsCounter;
+	ProfilerOverlay *_profilerOverlay;
 	bool _mouseActive;
 	unsigned int _timeOfLastFrame;
 	int _timeUntilNextFrame;
@@ -74,6 +76,8 @@ public:
 	Cursor *getCursor() const;
 	/// Gets the FpsCounter.
 	FpsCounter *getFpsCounter() const;
+	/// Gets the profiler overlay.
+	ProfilerOverlay *getProfilerOverlay() const;
 	/// Resets the state stack to a new state.
 	void setState(State *state);
 	/// Pushes a new state into the state stack.
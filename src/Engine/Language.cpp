@@ -21,12 +21,14 @@
 #include <cassert>
 #include <set>
 #include <climits>
+#include <cstring>
 #include <algorithm>
 #include "CrossPlatform.h"
 #include "Logger.h"
 #include "Options.h"
 #include "LanguagePlurality.h"
 #include "../Mod/ExtraStrings.h"
+#include "../Mod/RulesetCache.h"
 #ifdef _WIN32
 #ifndef NOMINMAX
 #define NOMINMAX
@@ -380,7 +382,19 @@ void Language::getList(std::vector<std::string> &files, std::vector<std::wstring
  */
 void Language::load(const std::string &filename)
 {
-	YAML::Node doc = YAML::LoadFile(filename);
+	// reuse the ruleset cache to skip parsing big translations
+	std::vector<std::string> files(1, filename);
+	std::vector<YAML::Node> docs;
+	RulesetCache cache(files);
+	if (!Options::rulesetCache || !cache.load(docs))
+	{
+		docs.assign(1, YAML::LoadFile(filename));
+		if (Options::rulesetCache)
+		{
+			cache.save(docs);
+		}
+	}
+	YAML::Node doc = docs[0];
 	YAML::Node lang;
 	if (doc.begin()->second.IsMap())
 	{
@@ -398,7 +412,7 @@ void Language::load(const std::string &filename)
 		// Regular strings
 		if (i->second.IsScalar())
 		{
-			_strings[i->first.as<std::string>()] = loadString(i->second.as<std::string>());
+			setString(i->first.as<std::string>(), loadString(i->second.as<std::string>()));
 		}
 		// Strings with plurality
 		else if (i->second.IsMap())
@@ -406,7 +420,7 @@ void Language::load(const std::string &filename)
 			for (YAML::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
 			{
 				std::string s = i->first.as<std::string>() + "_" + j->first.as<std::string>();
-				_strings[s] = loadString(j->second.as<std::string>());
+				setString(s, loadString(j->second.as<std::string>()));
 			}
 		}
 	}
@@ -440,7 +454,7 @@ void Language::load(ExtraStrings *extras)
 	{
 		for (std::map<std::string, std::string>::const_iterator i = extras->getStrings()->begin(); i != extras->getStrings()->end(); ++i)
 		{
-			_strings[i->first] = loadString(i->second);
+			setString(i->first, loadString(i->second));
 		}
 	}
 }
@@ -453,13 +467,119 @@ void Language::load(ExtraStrings *extras)
  */
 std::wstring Language::loadString(const std::string &string) const
 {
-	std::string s = string;
-	replace(s, "{NEWLINE}", "\n");
-	replace(s, "{SMALLLINE}", "\x02");
-	replace(s, "{ALT}", "\x01");
+	static const char *markers[] = { "{NEWLINE}", "{SMALLLINE}", "{ALT}" };
+	static const char replacements[] = { '\n', '\x02', '\x01' };
+	if (string.find('{') == std::string::npos)
+	{
+		return utf8ToWstr(string);
+	}
+	std::string s;
+	s.reserve(string.size());
+	for (size_t i = 0; i < string.size(); ++i)
+	{
+		bool replaced = false;
+		if (string[i] == '{')
+		{
+			for (size_t m = 0; m < sizeof(replacements) && !replaced; ++m)
+			{
+				size_t len = strlen(markers[m]);
+				if (string.compare(i, len, markers[m]) == 0)
+				{
+					s += replacements[m];
+					i += len - 1;
+					replaced = true;
+				}
+			}
+		}
+		if (!replaced)
+		{
+			s += string[i];
+		}
+	}
 	return utf8ToWstr(s);
 }
 
+/**
+ * Finds the slot in the string table for an ID made up of
+ * a base and a suffix, so plural and gender forms can be
+ * looked up without building the full ID.
+ * @param id Base of the string ID.
+ * @param suffix Suffix of the string ID.
+ * @return Slot holding the ID, or the empty slot it would go in.
+ */
+size_t Language::findBucket(const std::string &id, const char *suffix) const
+{
+	// FNV-1a
+	size_t hash = 2166136261u;
+	for (std::string::const_iterator c = id.begin(); c != id.end(); ++c)
+	{
+		hash = (hash ^ (unsigned char)*c) * 16777619u;
+	}
+	size_t suffixLength = 0;
+	for (const char *c = suffix; *c; ++c, ++suffixLength)
+	{
+		hash = (hash ^ (unsigned char)*c) * 16777619u;
+	}
+	size_t mask = _buckets.size() - 1;
+	size_t i = hash & mask;
+	while (_buckets[i] != 0)
+	{
+		const std::string &key = _keys[_buckets[i] - 1];
+		if (key.size() == id.size() + suffixLength && key.compare(0, id.size(), id) == 0 && key.compare(id.size(), suffixLength, suffix) == 0)
+		{
+			break;
+		}
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+/**
+ * Finds the string with an ID made up of a base and a suffix.
+ * @param id Base of the string ID.
+ * @param suffix Suffix of the string ID.
+ * @return Pointer to the string, or NULL if there isn't one.
+ */
+const LocalizedText *Language::findString(const std::string &id, const char *suffix) const
+{
+	if (_buckets.empty())
+	{
+		return 0;
+	}
+	size_t bucket = _buckets[findBucket(id, suffix)];
+	return bucket != 0 ? &_strings[bucket - 1] : 0;
+}
+
+/**
+ * Adds a string to the table, replacing any existing
+ * string with the same ID.
+ * @param id String ID.
+ * @param text Localized text.
+ */
+void Language::setString(const std::string &id, const std::wstring &text)
+{
+	// keep the table at most half full so probe chains stay short
+	if ((_keys.size() + 1) * 2 > _buckets.size())
+	{
+		_buckets.assign(std::max<size_t>(1024, _buckets.size() * 2), 0);
+		for (size_t i = 0; i < _keys.size(); ++i)
+		{
+			_buckets[findBucket(_keys[i], "")] = i + 1;
+		}
+	}
+	size_t bucket = findBucket(id, "");
+	if (_buckets[bucket] != 0)
+	{
+		_strings[_buckets[bucket] - 1] = LocalizedText(text);
+	}
+	else
+	{
+		_keys.push_back(id);
+		_strings.push_back(LocalizedText(text));
+		_buckets[bucket] = _keys.size();
+	}
+}
+
 /**
  * Returns the language's locale.
  * @return IANA language tag.
@@ -492,16 +612,16 @@ const LocalizedText &Language::getString(const std::string &id) const
 		hack = LocalizedText(L"");
 		return hack;
 	}
-	std::map<std::string, LocalizedText>::const_iterator s = _strings.find(id);
+	const LocalizedText *s = findString(id);
 	// Check if translation strings recently learned pluralization.
-	if (s == _strings.end())
+	if (s == 0)
 	{
 		hack = getString(id, UINT_MAX);
 		return hack;
 	}
 	else
 	{
-		return s->second;
+		return *s;
 	}
 }
 
@@ -517,24 +637,24 @@ LocalizedText Language::getString(const std::string &id, unsigned n) const
 {
 	assert(!id.empty());
 	static std::set<std::string> notFoundIds;
-	std::map<std::string, LocalizedText>::const_iterator s = _strings.end();
+	const LocalizedText *s = 0;
 	// Try specialized form.
 	if (n == 0)
 	{
-		s = _strings.find(id + "_zero");
+		s = findString(id, "_zero");
 	}
 	// Try proper form by language
-	if (s == _strings.end())
+	if (s == 0)
 	{
-		s = _strings.find(id + _handler->getSuffix(n));
+		s = findString(id, _handler->getSuffix(n));
 	}
 	// Try default form
-	if (s == _strings.end())
+	if (s == 0)
 	{
-		s = _strings.find(id + "_other");
+		s = findString(id, "_other");
 	}
 	// Give up
-	if (s == _strings.end())
+	if (s == 0)
 	{
 		if (notFoundIds.end() == notFoundIds.find(id))
 		{
@@ -551,13 +671,13 @@ LocalizedText Language::getString(const std::string &id, unsigned n) const
 			Log(LOG_WARNING) << id << " has plural format in ``" << Options::language << "``. Code assumes singular format.";
 //		Hint: Change ``getstring(ID).arg(value)`` to ``getString(ID, value)`` in appropriate files.
 		}
-		return s->second;
+		return *s;
 	}
 	else
 	{
 		std::wostringstream ss;
 		ss << n;
-		std::wstring marker(L"{N}"), val(ss.str()), txt(s->second);
+		std::wstring marker(L"{N}"), val(ss.str()), txt(*s);
 		replace(txt, marker, val);
 		return txt;
 	}
@@ -573,6 +693,11 @@ LocalizedText Language::getString(const std::string &id, unsigned n) const
  */
 const LocalizedText &Language::getString(const std::string &id, SoldierGender gender) const
 {
+	const LocalizedText *s = findString(id, gender == GENDER_MALE ? "_MALE" : "_FEMALE");
+	if (s != 0)
+	{
+		return *s;
+	}
 	std::string genderId;
 	if (gender == GENDER_MALE)
 	{
@@ -595,10 +720,15 @@ void Language::toHtml(const std::string &filename) const
 	std::ofstream htmlFile (filename.c_str(), std::ios::out);
 	htmlFile << "<table border=\"1\" width=\"100%\">" << std::endl;
 	htmlFile << "<tr><th>ID String</th><th>English String</th></tr>" << std::endl;
-	for (std::map<std::string, LocalizedText>::const_iterator i = _strings.begin(); i != _strings.end(); ++i)
+	std::map<std::string, size_t> sorted;
+	for (size_t i = 0; i < _keys.size(); ++i)
+	{
+		sorted[_keys[i]] = i;
+	}
+	for (std::map<std::string, size_t>::const_iterator i = sorted.begin(); i != sorted.end(); ++i)
 	{
 		htmlFile << "<tr><td>" << i->first << "</td><td>";
-		std::string s = wstrToUtf8(i->second);
+		std::string s = wstrToUtf8(_strings[i->second]);
 		for (std::string::const_iterator j = s.begin(); j != s.end(); ++j)
 		{
 			if (*j == 2 || *j == '\n')
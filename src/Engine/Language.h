@@ -40,7 +40,9 @@ class Language
 {
 private:
 	std::string _id;
-	std::map<std::string, LocalizedText> _strings;
+	std::vector<std::string> _keys;
+	std::vector<LocalizedText> _strings;
+	std::vector<size_t> _buckets;
 	LanguagePlurality *_handler;
 	TextDirection _direction;
 	TextWrapping _wrap;
@@ -50,6 +52,12 @@ private:
 
 	/// Parses a text string loaded from an external file.
 	std::wstring loadString(const std::string &s) const;
+	/// Finds the table slot of a string ID.
+	size_t findBucket(const std::string &id, const char *suffix) const;
+	/// Finds the string with an ID.
+	const LocalizedText *findString(const std::string &id, const char *suffix = "") const;
+	/// Adds or replaces the string with an ID.
+	void setString(const std::string &id, const std::wstring &text);
 public:
 	/// Creates a blank language.
 	Language();
@@ -0,0 +1,273 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Logger.h"
+#include <cstdio>
+#include <SDL_thread.h>
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Size the log file can reach before it's moved aside.
+const long MAX_LOG_SIZE = 16 * 1024 * 1024;
+
+/**
+ * Owns the log file and the thread writing queued lines to it.
+ * The file mutex is always taken before the queue mutex.
+ */
+class LogWriter
+{
+private:
+	SDL_mutex *_fileMutex, *_queueMutex;
+	SDL_cond *_wake;
+	SDL_Thread *_thread;
+	std::string _pending, _pendingFile, _fileName;
+	FILE *_file;
+	long _size;
+	bool _quit;
+
+	/**
+	 * Opens the log file for appending, moving it aside
+	 * first if it's grown too big.
+	 * @param filename Path to the log file.
+	 */
+	void open(const std::string &filename)
+	{
+		if (_file)
+		{
+			fclose(_file);
+		}
+		_fileName = filename;
+		_file = fopen(_fileName.c_str(), "a");
+		_size = 0;
+		if (_file && fseek(_file, 0, SEEK_END) == 0)
+		{
+			_size = ftell(_file);
+		}
+		if (_file && _size > MAX_LOG_SIZE)
+		{
+			fclose(_file);
+			std::string old = _fileName + ".old";
+			remove(old.c_str());
+			rename(_fileName.c_str(), old.c_str());
+			_file = fopen(_fileName.c_str(), "a");
+			_size = 0;
+		}
+	}
+
+	/**
+	 * Writes out everything queued so far.
+	 * Must be called with the file mutex held.
+	 */
+	void writeQueued()
+	{
+		std::string text, filename;
+		SDL_LockMutex(_queueMutex);
+		text.swap(_pending);
+		filename = _pendingFile;
+		SDL_UnlockMutex(_queueMutex);
+		if (text.empty())
+		{
+			return;
+		}
+		if (!_file || filename != _fileName || _size > MAX_LOG_SIZE)
+		{
+			open(filename);
+		}
+		if (_file)
+		{
+			fputs(text.c_str(), _file);
+			fflush(_file);
+			_size += text.size();
+		}
+		else if (Logger::reportingLevel() != LOG_DEBUG && Logger::reportingLevel() != LOG_VERBOSE)
+		{
+			// not echoed already
+			fputs(text.c_str(), stderr);
+			fflush(stderr);
+		}
+	}
+
+	/**
+	 * Writes out queued lines whenever there's any.
+	 * @param writer_ptr Pointer to the writer.
+	 * @return Always zero.
+	 */
+	static int run(void *writer_ptr)
+	{
+		LogWriter *writer = (LogWriter*)writer_ptr;
+		bool quit = false;
+		while (!quit)
+		{
+			SDL_LockMutex(writer->_queueMutex);
+			while (writer->_pending.empty() && !writer->_quit)
+			{
+				SDL_CondWait(writer->_wake, writer->_queueMutex);
+			}
+			quit = writer->_quit;
+			SDL_UnlockMutex(writer->_queueMutex);
+
+			SDL_LockMutex(writer->_fileMutex);
+			writer->writeQueued();
+			SDL_UnlockMutex(writer->_fileMutex);
+		}
+		return 0;
+	}
+public:
+	/**
+	 * Starts the writer thread. If it can't be started,
+	 * every line is written out immediately instead.
+	 */
+	LogWriter() : _thread(0), _file(0), _size(0), _quit(false)
+	{
+		_fileMutex = SDL_CreateMutex();
+		_queueMutex = SDL_CreateMutex();
+		_wake = SDL_CreateCond();
+		if (_fileMutex && _queueMutex && _wake)
+		{
+			_thread = SDL_CreateThread(run, this);
+		}
+	}
+
+	/**
+	 * Stops the writer thread and writes out whatever's left.
+	 */
+	~LogWriter()
+	{
+		if (_thread)
+		{
+			SDL_LockMutex(_queueMutex);
+			_quit = true;
+			SDL_CondSignal(_wake);
+			SDL_UnlockMutex(_queueMutex);
+			SDL_WaitThread(_thread, 0);
+			_thread = 0;
+		}
+		flush();
+		if (_file)
+		{
+			fclose(_file);
+		}
+		SDL_DestroyCond(_wake);
+		SDL_DestroyMutex(_queueMutex);
+		SDL_DestroyMutex(_fileMutex);
+	}
+
+	/**
+	 * Adds a line to the queue.
+	 * @param line Formatted log line.
+	 * @param filename Log file it goes to.
+	 * @param sync Write it out before returning?
+	 */
+	void write(const std::string &line, const std::string &filename, bool sync)
+	{
+		sync = sync || !_thread;
+		if (sync)
+		{
+			SDL_LockMutex(_fileMutex);
+		}
+		SDL_LockMutex(_queueMutex);
+		_pending += line;
+		if (_pendingFile != filename)
+		{
+			_pendingFile = filename;
+		}
+		if (!sync)
+		{
+			SDL_CondSignal(_wake);
+		}
+		SDL_UnlockMutex(_queueMutex);
+		if (sync)
+		{
+			writeQueued();
+			SDL_UnlockMutex(_fileMutex);
+		}
+	}
+
+	/**
+	 * Writes out all the queued lines.
+	 */
+	void flush()
+	{
+		SDL_LockMutex(_fileMutex);
+		writeQueued();
+		SDL_UnlockMutex(_fileMutex);
+	}
+};
+
+/**
+ * Gets the shared log writer, creating it on first use.
+ * @return Log writer.
+ */
+LogWriter &getWriter()
+{
+	static LogWriter writer;
+	return writer;
+}
+
+}
+
+/**
+ * Timestamps a finished log line and queues it for the log file.
+ * Errors are written out before returning so they're not lost
+ * if the game goes down right after. Fatal errors come from crash
+ * handlers, so whatever's queued is written out first to keep the
+ * lines leading up to the crash, then they go straight to the file.
+ * @param level Severity of the line.
+ * @param line Formatted log line.
+ */
+void Logger::write(SeverityLevel level, const std::string &line)
+{
+	std::string stamped = "[" + CrossPlatform::now() + "]\t" + line;
+	bool echo = reportingLevel() == LOG_DEBUG || reportingLevel() == LOG_VERBOSE;
+	if (level == LOG_FATAL)
+	{
+		flush();
+		FILE *file = fopen(logFile().c_str(), "a");
+		if (file)
+		{
+			fprintf(file, "%s", stamped.c_str());
+			fflush(file);
+			fclose(file);
+		}
+		echo = echo || !file;
+	}
+	else
+	{
+		getWriter().write(stamped, logFile(), level <= LOG_ERROR);
+	}
+	if (echo)
+	{
+		fprintf(stderr, "%s", line.c_str());
+		fflush(stderr);
+	}
+}
+
+/**
+ * Writes out all the queued log lines, for when
+ * the log needs to be up to date (eg. before a crash report).
+ */
+void Logger::flush()
+{
+	getWriter().flush();
+}
+
+}
@@ -45,6 +45,8 @@ enum SeverityLevel
 /**
  * A basic logging and debugging class, prints output to stdout/files
  * and can capture stack traces of fatal errors too.
+ * Lines are handed to a background thread that writes them to the
+ * log file, except errors which are written out straight away.
  * @note Wasn't really satisfied with any of the libraries around
  * so I rolled my own. Based on http://www.drdobbs.com/cpp/logging-in-c/201804215
  */
@@ -58,19 +60,25 @@ public:
 	static SeverityLevel& reportingLevel();
 	static std::string& logFile();
 	static std::string toString(SeverityLevel level);
+	/// Queues a line to be written to the log file.
+	static void write(SeverityLevel level, const std::string &line);
+	/// Writes out all the queued lines.
+	static void flush();
 protected:
 	std::ostringstream os;
+	SeverityLevel _level;
 private:
 	Logger(const Logger&);
 	Logger& operator =(const Logger&);
 };
 
-inline Logger::Logger()
+inline Logger::Logger() : _level(LOG_INFO)
 {
 }
 
 inline std::ostringstream& Logger::get(SeverityLevel level)
 {
+	_level = level;
 	os << "[" << toString(level) << "]" << "\t";
 	return os;
 }
@@ -78,20 +86,7 @@ inline std::ostringstream& Logger::get(SeverityLevel level)
 inline Logger::~Logger()
 {
 	os << std::endl;
-	std::ostringstream ss;
-	ss << "[" << CrossPlatform::now() << "]" << "\t" << os.str();
-	FILE *file = fopen(logFile().c_str(), "a");
-	if (file)
-	{
-		fprintf(file, "%s", ss.str().c_str());
-		fflush(file);
-		fclose(file);
-	}
-	if (!file || reportingLevel() == LOG_DEBUG || reportingLevel() == LOG_VERBOSE)
-	{
-		fprintf(stderr, "%s", os.str().c_str());
-		fflush(stderr);
-	}
+	write(_level, os.str());
 }
 
 inline SeverityLevel& Logger::reportingLevel()
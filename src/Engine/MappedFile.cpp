@@ -0,0 +1,124 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MappedFile.h"
+#include <fstream>
+#include <iterator>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace OpenXcom
+{
+
+/**
+ * Opens a file and maps its whole contents into memory.
+ * If mapping isn't possible, the file is read into a buffer instead.
+ * @param filename Full path to the file.
+ */
+MappedFile::MappedFile(const std::string &filename) : _data(0), _size(0), _open(false)
+{
+#ifdef _WIN32
+	_file = 0;
+	_mapping = 0;
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+		{
+			HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+			if (mapping != 0)
+			{
+				_data = (const Uint8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				if (_data != 0)
+				{
+					_size = (size_t)size.QuadPart;
+					_mapping = mapping;
+					_file = file;
+					_open = true;
+					return;
+				}
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+	}
+#else
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd != -1)
+	{
+		struct stat info;
+		if (fstat(fd, &info) == 0 && info.st_size > 0)
+		{
+			void *data = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED)
+			{
+				_data = (const Uint8*)data;
+				_size = info.st_size;
+				_open = true;
+			}
+		}
+		// the mapping stays valid after the file is closed
+		close(fd);
+		if (_open)
+		{
+			return;
+		}
+	}
+#endif
+
+	// couldn't map it (or it's empty), just read it in
+	std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+	if (file)
+	{
+		_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		_data = _buffer.empty() ? 0 : &_buffer[0];
+		_size = _buffer.size();
+		_open = true;
+	}
+}
+
+/**
+ * Releases the mapping, if any.
+ */
+MappedFile::~MappedFile()
+{
+	if (_data == 0 || !_buffer.empty())
+	{
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(_data);
+	CloseHandle(_mapping);
+	CloseHandle(_file);
+#else
+	munmap((void*)_data, _size);
+#endif
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <SDL.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Read-only view of a whole file in memory. The file is mapped
+ * directly into the address space where the platform allows it,
+ * so it can be decoded in bulk without any intermediate copies
+ * or per-byte read calls. Falls back to reading it into a buffer.
+ */
+class MappedFile
+{
+private:
+	const Uint8 *_data;
+	size_t _size;
+	bool _open;
+	std::vector<Uint8> _buffer;
+#ifdef _WIN32
+	void *_file, *_mapping;
+#endif
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+public:
+	/// Maps a file into memory.
+	MappedFile(const std::string &filename);
+	/// Unmaps the file.
+	~MappedFile();
+	/// Checks if the file couldn't be opened.
+	bool operator !() const { return !_open; }
+	/// Gets the file contents.
+	const Uint8 *getData() const { return _data; }
+	/// Gets the file size.
+	size_t getSize() const { return _size; }
+};
+
+}
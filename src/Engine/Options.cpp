@@ -73,6 +73,10 @@ void create()
 #endif
 
 	_info.push_back(OptionInfo("maxFrameSkip", &maxFrameSkip, 0));
+	_info.push_back(OptionInfo("workerThreads", &workerThreads, 0)); // 0 = one per core
+	_info.push_back(OptionInfo("rulesetCache", &rulesetCache, true));
+	_info.push_back(OptionInfo("fileMapCache", &fileMapCache, true));
+	_info.push_back(OptionInfo("adlibCache", &adlibCache, false));
 	_info.push_back(OptionInfo("traceAI", &traceAI, false));
 	_info.push_back(OptionInfo("verboseLogging", &verboseLogging, false));
 	_info.push_back(OptionInfo("StereoSound", &StereoSound, true));
@@ -94,6 +98,7 @@ void create()
 	_info.push_back(OptionInfo("useOpenGLSmoothing", &useOpenGLSmoothing, true));
 	_info.push_back(OptionInfo("debug", &debug, false));
 	_info.push_back(OptionInfo("debugUi", &debugUi, false));
+	_info.push_back(OptionInfo("profiler", &profiler, false));
 	_info.push_back(OptionInfo("soundVolume", &soundVolume, 2*(MIX_MAX_VOLUME/3)));
 	_info.push_back(OptionInfo("musicVolume", &musicVolume, 2*(MIX_MAX_VOLUME/3)));
 	_info.push_back(OptionInfo("uiVolume", &uiVolume, MIX_MAX_VOLUME/3));
@@ -380,6 +385,22 @@ void loadArgs(int argc, char *argv[])
 				{
 					_configFolder = CrossPlatform::endPath(argv[i]);
 				}
+				else if (argname == "benchmark")
+				{
+					benchmarkSave = argv[i];
+				}
+				else if (argname == "benchmarkdays")
+				{
+					std::istringstream(argv[i]) >> benchmarkDays;
+				}
+				else if (argname == "benchmarkbattle")
+				{
+					benchmarkBattle = argv[i];
+				}
+				else if (argname == "benchmarkoutput")
+				{
+					benchmarkOutput = argv[i];
+				}
 				else
 				{
 					//save this command line option for now, we will apply it later
@@ -410,6 +431,14 @@ bool showHelp(int argc, char *argv[])
 	help << "        use PATH as the default User Folder instead of auto-detecting" << std::endl << std::endl;
 	help << "-cfg PATH  or  -config PATH" << std::endl;
 	help << "        use PATH as the default Config Folder instead of auto-detecting" << std::endl << std::endl;
+	help << "-benchmark SAVE" << std::endl;
+	help << "        run the Geoscape on SAVE without a display and report timings (see -benchmarkDays)" << std::endl << std::endl;
+	help << "-benchmarkDays DAYS" << std::endl;
+	help << "        number of game days to run the benchmark for (default 30)" << std::endl << std::endl;
+	help << "-benchmarkBattle SAVE" << std::endl;
+	help << "        run the Battlescape routines on the battle in SAVE without a display and report timings" << std::endl << std::endl;
+	help << "-benchmarkOutput FILE" << std::endl;
+	help << "        also save the benchmark timings to FILE as JSON" << std::endl << std::endl;
 	help << "-KEY VALUE" << std::endl;
 	help << "        set option KEY to VALUE instead of default/loaded value (eg. -displayWidth 640)" << std::endl << std::endl;
 	help << "-help" << std::endl;
@@ -742,6 +771,7 @@ void mapResources()
 	}
 	// TODO: Figure out why we still need to check common here
 	FileMap::load("common", CrossPlatform::searchDataFolder("common"), true);
+	FileMap::save();
 	Log(LOG_INFO) << "Resources files mapped successfully.";
 }
 
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "CrossPlatform.h"
+#include "Logger.h"
+#include "Options.h"
+
+namespace OpenXcom
+{
+
+namespace Profiler
+{
+	/**
+	 * Time spent in a section for every frame of the window.
+	 */
+	struct Section
+	{
+		const char *name;
+		Uint64 frames[FRAMES];
+	};
+
+	/**
+	 * A single timed section, as stored in a trace.
+	 */
+	struct TraceEvent
+	{
+		const char *name;
+		Uint64 start, duration;
+	};
+
+	/// Maximum number of events kept in a trace, about 24MB.
+	const size_t MAX_TRACE_EVENTS = 1000000;
+
+	Uint32 mainThread = 0;
+	int frame = 0;
+	bool tracing = false;
+	Uint64 traceStart = 0;
+	std::vector<Section> sections;
+	std::vector<TraceEvent> trace;
+
+/**
+ * Starts timing a section. Names must be string literals,
+ * as only the pointer is kept.
+ * @param name Name of the section.
+ */
+Scope::Scope(const char *name) : _name(name), _start(0)
+{
+	if (isActive())
+	{
+		_start = CrossPlatform::getMicroseconds();
+	}
+}
+
+/**
+ * Stops timing the section and records it.
+ */
+Scope::~Scope()
+{
+	if (_start != 0)
+	{
+		record(_name, _start, CrossPlatform::getMicroseconds());
+	}
+}
+
+/**
+ * Remembers the calling thread as the one to measure.
+ * Must be called from the main thread.
+ */
+void init()
+{
+	mainThread = SDL_ThreadID();
+}
+
+/**
+ * Checks if timings are being collected, either for
+ * the overlay or for a trace.
+ * @return True if profiling is on.
+ */
+bool isActive()
+{
+	return (Options::profiler || tracing) && SDL_ThreadID() == mainThread;
+}
+
+/**
+ * Moves on to the next frame of the rolling window,
+ * discarding the oldest one.
+ */
+void beginFrame()
+{
+	frame = (frame + 1) % FRAMES;
+	for (std::vector<Section>::iterator i = sections.begin(); i != sections.end(); ++i)
+	{
+		i->frames[frame] = 0;
+	}
+}
+
+/**
+ * Adds the time spent in a section to the current frame,
+ * and to the trace if one is being recorded.
+ * @param name Name of the section.
+ * @param start Timestamp the section started at.
+ * @param end Timestamp the section ended at.
+ */
+void record(const char *name, Uint64 start, Uint64 end)
+{
+	std::vector<Section>::iterator i = sections.begin();
+	while (i != sections.end() && i->name != name && strcmp(i->name, name) != 0)
+	{
+		++i;
+	}
+	if (i == sections.end())
+	{
+		Section section;
+		section.name = name;
+		std::fill(section.frames, section.frames + FRAMES, 0);
+		sections.push_back(section);
+		i = sections.end() - 1;
+	}
+	i->frames[frame] += end - start;
+
+	if (tracing && start >= traceStart && trace.size() < MAX_TRACE_EVENTS)
+	{
+		TraceEvent event;
+		event.name = name;
+		event.start = start - traceStart;
+		event.duration = end - start;
+		trace.push_back(event);
+	}
+}
+
+/**
+ * Gets the average and peak time per frame of every section
+ * over the rolling window, in microseconds.
+ * @param summary List to fill with the sections.
+ */
+void getSummary(std::vector<Summary> &summary)
+{
+	summary.clear();
+	for (std::vector<Section>::const_iterator i = sections.begin(); i != sections.end(); ++i)
+	{
+		Summary s;
+		s.name = i->name;
+		s.average = 0;
+		s.peak = 0;
+		for (int j = 0; j < FRAMES; ++j)
+		{
+			s.average += i->frames[j];
+			s.peak = std::max(s.peak, i->frames[j]);
+		}
+		s.average /= FRAMES;
+		summary.push_back(s);
+	}
+}
+
+/**
+ * Checks if a trace is being recorded.
+ * @return True if tracing.
+ */
+bool isTracing()
+{
+	return tracing;
+}
+
+/**
+ * Starts recording every timed section into a trace.
+ */
+void startTrace()
+{
+	trace.clear();
+	traceStart = CrossPlatform::getMicroseconds();
+	tracing = true;
+	Log(LOG_INFO) << "Profiler trace started.";
+}
+
+/**
+ * Stops recording the trace and saves it in the Chrome
+ * trace event format, which can be opened in chrome://tracing.
+ * @param filename Full path of the file to save to.
+ */
+void stopTrace(const std::string &filename)
+{
+	if (!tracing)
+	{
+		return;
+	}
+	tracing = false;
+	std::ofstream out(filename.c_str());
+	if (!out)
+	{
+		Log(LOG_ERROR) << "Failed to save profiler trace to " << filename;
+	}
+	else
+	{
+		out << "{\"traceEvents\":[";
+		for (std::vector<TraceEvent>::const_iterator i = trace.begin(); i != trace.end(); ++i)
+		{
+			if (i != trace.begin())
+			{
+				out << ",";
+			}
+			out << "\n{\"name\":\"" << i->name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << i->start << ",\"dur\":" << i->duration << "}";
+		}
+		out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+		Log(LOG_INFO) << "Profiler trace with " << trace.size() << " events saved to " << filename;
+	}
+	std::vector<TraceEvent>().swap(trace);
+}
+}
+
+}
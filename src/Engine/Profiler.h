@@ -0,0 +1,81 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <string>
+#include <SDL.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Lightweight instrumentation of the main loop and the heavier
+ * game systems. Timings are collected per frame into a rolling
+ * window for the in-game overlay, and optionally recorded as a
+ * trace that can be loaded in chrome://tracing.
+ * Only the main thread is measured, anything else is ignored.
+ */
+namespace Profiler
+{
+	/// Number of frames kept in the rolling window.
+	const int FRAMES = 60;
+
+	/**
+	 * Average and worst time of a section over the rolling window.
+	 */
+	struct Summary
+	{
+		const char *name;
+		Uint64 average, peak;
+	};
+
+	/**
+	 * Measures the time spent in a C++ scope, if profiling is on.
+	 */
+	class Scope
+	{
+	private:
+		const char *_name;
+		Uint64 _start;
+	public:
+		/// Starts timing a section.
+		Scope(const char *name);
+		/// Stops timing the section.
+		~Scope();
+	};
+
+	/// Sets up the profiler on the main thread.
+	void init();
+	/// Checks if timings are being collected.
+	bool isActive();
+	/// Starts a new frame in the rolling window.
+	void beginFrame();
+	/// Records the time spent in a section.
+	void record(const char *name, Uint64 start, Uint64 end);
+	/// Gets the summary of every section.
+	void getSummary(std::vector<Summary> &summary);
+	/// Checks if a trace is being recorded.
+	bool isTracing();
+	/// Starts recording a trace.
+	void startTrace();
+	/// Stops recording a trace and saves it.
+	void stopTrace(const std::string &filename);
+}
+
+}
@@ -36,6 +36,7 @@
 #include "../Interface/ComboBox.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/FpsCounter.h"
+#include "../Interface/ProfilerOverlay.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Mod/RuleInterface.h"
 
@@ -251,7 +252,11 @@ void State::init()
 	if (_game->getMod() != 0)
 	{
 		_game->getMod()->setPalette(_palette);
+		_game->getProfilerOverlay()->initText(_game->getMod()->getFont("FONT_BIG"), _game->getMod()->getFont("FONT_SMALL"), _game->getLanguage());
 	}
+	_game->getProfilerOverlay()->setPalette(_palette);
+	_game->getProfilerOverlay()->setColor(_cursorColor);
+	_game->getProfilerOverlay()->draw();
 	for (std::vector<Surface*>::iterator i = _surfaces.begin(); i != _surfaces.end(); ++i)
 	{
 		Window* window = dynamic_cast<Window*>(*i);
@@ -466,6 +471,8 @@ void State::setPalette(SDL_Color *colors, int firstcolor, int ncolors, bool imme
 		_game->getCursor()->draw();
 		_game->getFpsCounter()->setPalette(_palette);
 		_game->getFpsCounter()->draw();
+		_game->getProfilerOverlay()->setPalette(_palette);
+		_game->getProfilerOverlay()->draw();
 		if (_game->getMod() != 0)
 		{
 			_game->getMod()->setPalette(_palette);
@@ -28,7 +28,10 @@
 #include "Exception.h"
 #include "Logger.h"
 #include "ShaderMove.h"
+#include "WorkerPool.h"
 #include <stdlib.h>
+#include <string.h>
+#include <map>
 #ifdef _WIN32
 #include <malloc.h>
 #endif
@@ -121,6 +124,71 @@ inline void DeleteAligned(void* buffer)
 	}
 }
 
+/**
+ * An 8-bit PNG image decoded ahead of being loaded into a surface.
+ */
+struct DecodedImage
+{
+	std::vector<unsigned char> pixels, palette;
+	unsigned width, height;
+	DecodedImage() : width(0), height(0) {}
+};
+
+/// Images decoded by Surface::preloadImages, waiting to be loaded.
+/// Images that aren't 8-bit PNGs are kept with no pixels.
+std::map<std::string, DecodedImage> preloadedImages;
+
+/**
+ * Helper function decoding an 8-bit PNG file with LodePNG.
+ * @param filename Filename of the image.
+ * @param image Decoded image.
+ * @return False if it's not an 8-bit PNG.
+ */
+bool DecodePng(const std::string &filename, DecodedImage &image)
+{
+	std::vector<unsigned char> png;
+	if (lodepng::load_file(png, filename))
+	{
+		return false;
+	}
+	lodepng::State state;
+	state.decoder.color_convert = 0;
+	// check the header first so other formats aren't decoded for nothing
+	if (lodepng_inspect(&image.width, &image.height, &state, png.empty() ? 0 : &png[0], png.size()) || lodepng_get_bpp(&state.info_png.color) != 8)
+	{
+		return false;
+	}
+	if (lodepng::decode(image.pixels, image.width, image.height, state, png))
+	{
+		return false;
+	}
+	LodePNGColorMode *color = &state.info_png.color;
+	image.palette.assign(color->palette, color->palette + color->palettesize * 4);
+	return true;
+}
+
+/**
+ * An image to decode on a worker thread.
+ */
+struct DecodeJob
+{
+	std::string filename;
+	DecodedImage image;
+	bool decoded;
+};
+
+/**
+ * Decodes one image of a batch. Decoding never throws,
+ * images that fail are just loaded the regular way later.
+ * @param data Pointer to the list of jobs.
+ * @param index Index of the image to decode.
+ */
+void DecodePngJob(void *data, size_t index)
+{
+	DecodeJob &job = (*(std::vector<DecodeJob>*)data)[index];
+	job.decoded = DecodePng(job.filename, job.image);
+}
+
 } //namespace
 
 /**
@@ -258,45 +326,50 @@ void Surface::loadImage(const std::string &filename)
 
 	Log(LOG_VERBOSE) << "Loading image: " << filename;
 
-	// Try loading with LodePNG first
-	std::vector<unsigned char> png;
-	unsigned error = lodepng::load_file(png, filename);
-	if (!error)
+	// Try loading with LodePNG first, unless it's been done already
+	DecodedImage image;
+	bool decoded;
+	std::map<std::string, DecodedImage>::iterator preloaded = preloadedImages.find(filename);
+	if (preloaded != preloadedImages.end())
+	{
+		image.pixels.swap(preloaded->second.pixels);
+		image.palette.swap(preloaded->second.palette);
+		image.width = preloaded->second.width;
+		image.height = preloaded->second.height;
+		preloadedImages.erase(preloaded);
+		decoded = !image.pixels.empty();
+	}
+	else
+	{
+		decoded = DecodePng(filename, image);
+	}
+	if (decoded)
 	{
-		std::vector<unsigned char> image;
-		unsigned width, height;
-		lodepng::State state;
-		state.decoder.color_convert = 0;
-		error = lodepng::decode(image, width, height, state, png);
-		if (!error)
+		const int bpp = 8;
+		_alignedBuffer = NewAligned(bpp, image.width, image.height);
+		_surface = SDL_CreateRGBSurfaceFrom(_alignedBuffer, image.width, image.height, bpp, GetPitch(bpp, image.width), 0, 0, 0, 0);
+		if (_surface)
 		{
-			LodePNGColorMode *color = &state.info_png.color;
-			unsigned bpp = lodepng_get_bpp(color);
-			if (bpp == 8)
+			// rows are already in the surface's format, just copy them over
+			for (unsigned y = 0; y < image.height; ++y)
 			{
-				_alignedBuffer = NewAligned(bpp, width, height);
-				_surface = SDL_CreateRGBSurfaceFrom(_alignedBuffer, width, height, bpp, GetPitch(bpp, width), 0, 0, 0, 0);
-				if (_surface)
+				memcpy((Uint8*)_surface->pixels + y * _surface->pitch, &image.pixels[y * image.width], image.width);
+			}
+			if (!image.palette.empty())
+			{
+				setPalette((SDL_Color*)&image.palette[0], 0, image.palette.size() / 4);
+			}
+			int transparent = 0;
+			for (int c = 0; c < _surface->format->palette->ncolors; ++c)
+			{
+				SDL_Color *palColor = _surface->format->palette->colors + c;
+				if (palColor->unused == 0)
 				{
-					int x = 0, y = 0;
-					for (std::vector<unsigned char>::const_iterator i = image.begin(); i != image.end(); ++i)
-					{
-						setPixelIterative(&x, &y, *i);
-					}
-					setPalette((SDL_Color*)color->palette, 0, color->palettesize);
-					int transparent = 0;
-					for (int c = 0; c < _surface->format->palette->ncolors; ++c)
-					{
-						SDL_Color *palColor = _surface->format->palette->colors + c;
-						if (palColor->unused == 0)
-						{
-							transparent = c;
-							break;
-						}
-					}
-					SDL_SetColorKey(_surface, SDL_SRCCOLORKEY, transparent);
+					transparent = c;
+					break;
 				}
 			}
+			SDL_SetColorKey(_surface, SDL_SRCCOLORKEY, transparent);
 		}
 	}
 
@@ -316,6 +389,43 @@ void Surface::loadImage(const std::string &filename)
 	}
 }
 
+/**
+ * Decodes a batch of PNG images across worker threads ahead of time,
+ * so loading them into surfaces afterwards is just a copy.
+ * Images that can't be decoded are remembered, so loadImage() goes
+ * straight to SDL_Image for them instead of trying again.
+ * @param filenames Filenames of the images.
+ */
+void Surface::preloadImages(const std::vector<std::string> &filenames)
+{
+	std::vector<DecodeJob> jobs(filenames.size());
+	for (size_t i = 0; i < filenames.size(); ++i)
+	{
+		jobs[i].filename = filenames[i];
+		jobs[i].decoded = false;
+	}
+	WorkerPool::run(DecodePngJob, &jobs, jobs.size());
+	for (std::vector<DecodeJob>::iterator i = jobs.begin(); i != jobs.end(); ++i)
+	{
+		DecodedImage &image = preloadedImages[i->filename];
+		if (i->decoded)
+		{
+			image.pixels.swap(i->image.pixels);
+			image.palette.swap(i->image.palette);
+		}
+		image.width = i->image.width;
+		image.height = i->image.height;
+	}
+}
+
+/**
+ * Discards any preloaded images that were never loaded.
+ */
+void Surface::clearPreloadedImages()
+{
+	preloadedImages.clear();
+}
+
 /**
  * Loads the contents of an X-Com SPK image file into
  * the surface. SPK files are compressed with a custom
@@ -19,6 +19,7 @@
  */
 #include <SDL.h>
 #include <string>
+#include <vector>
 
 namespace OpenXcom
 {
@@ -59,6 +60,10 @@ public:
 	void loadBdy(const std::string &filename);
 	/// Loads a general image file.
 	void loadImage(const std::string &filename);
+	/// Decodes a batch of image files in parallel.
+	static void preloadImages(const std::vector<std::string> &filenames);
+	/// Discards unused preloaded images.
+	static void clearPreloadedImages();
 	/// Clears the surface's contents eith a specified colour.
 	void clear(Uint32 color = 0);
 	/// Offsets the surface's colors by a set amount.
@@ -17,8 +17,9 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "SurfaceSet.h"
-#include <fstream>
+#include <cstring>
 #include "Surface.h"
+#include "MappedFile.h"
 #include "Exception.h"
 
 namespace OpenXcom
@@ -76,18 +77,17 @@ void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
 	// Load TAB and get image offsets
 	if (!tab.empty())
 	{
-		std::ifstream offsetFile(tab.c_str(), std::ios::in | std::ios::binary);
+		MappedFile offsetFile(tab);
 		if (!offsetFile)
 		{
 			throw Exception(tab + " not found");
 		}
-		std::streampos begin, end;
-		begin = offsetFile.tellg();
-		int off;
-		offsetFile.read((char*)&off, sizeof(off));
-		offsetFile.seekg(0, std::ios::end);
-		end = offsetFile.tellg();
-		int size = end - begin;
+		size_t size = offsetFile.getSize();
+		Uint32 off = 0;
+		if (size >= sizeof(off))
+		{
+			memcpy(&off, offsetFile.getData(), sizeof(off));
+		}
 		// 16-bit offsets
 		if (off != 0)
 		{
@@ -98,7 +98,6 @@ void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
 		{
 			nframes = size / 4;
 		}
-		offsetFile.close();
 		for (int frame = 0; frame < nframes; ++frame)
 		{
 			_frames[frame] = new Surface(_width, _height);
@@ -111,51 +110,61 @@ void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
 	}
 
 	// Load PCK and put pixels in surfaces
-	std::ifstream imgFile (pck.c_str(), std::ios::in | std::ios::binary);
+	MappedFile imgFile(pck);
 	if (!imgFile)
 	{
 		throw Exception(pck + " not found");
 	}
 
-	Uint8 value;
+	const Uint8 *data = imgFile.getData();
+	const Uint8 *end = data + imgFile.getSize();
+	const int total = _width * _height;
 
-	for (int frame = 0; frame < nframes; ++frame)
+	for (int frame = 0; frame < nframes && data != end; ++frame)
 	{
-		int x = 0, y = 0;
-
 		// Lock the surface
-		_frames[frame]->lock();
-
-		imgFile.read((char*)&value, 1);
-		for (int i = 0; i < value; ++i)
+		Surface *surface = _frames[frame];
+		surface->lock();
+		Uint8 *pixels = (Uint8*)surface->getSurface()->pixels;
+		int pitch = surface->getSurface()->pitch;
+
+		// surfaces start out blank, so transparent runs are just skipped
+		int pos = *data++ * _width;
+		Uint8 *row = pixels + (pos / _width) * pitch;
+		int x = 0;
+		while (data != end)
 		{
-			for (int j = 0; j < _width; ++j)
+			Uint8 value = *data++;
+			if (value == 255)
 			{
-				_frames[frame]->setPixelIterative(&x, &y, 0);
+				break;
 			}
-		}
-
-		while (imgFile.read((char*)&value, 1) && value != 255)
-		{
-			if (value == 254)
+			else if (value == 254)
 			{
-				imgFile.read((char*)&value, 1);
-				for (int i = 0; i < value; ++i)
-				{
-					_frames[frame]->setPixelIterative(&x, &y, 0);
-				}
+				if (data == end)
+					break;
+				pos += *data++;
+				row = pixels + (pos / _width) * pitch;
+				x = pos % _width;
 			}
 			else
 			{
-				_frames[frame]->setPixelIterative(&x, &y, value);
+				if (pos < total)
+				{
+					row[x] = value;
+				}
+				++pos;
+				if (++x == _width)
+				{
+					x = 0;
+					row += pitch;
+				}
 			}
 		}
 
 		// Unlock the surface
-		_frames[frame]->unlock();
+		surface->unlock();
 	}
-
-	imgFile.close();
 }
 
 /**
@@ -168,54 +177,31 @@ void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
  */
 void SurfaceSet::loadDat(const std::string &filename)
 {
-	int nframes = 0;
-
 	// Load file and put pixels in surface
-	std::ifstream imgFile (filename.c_str(), std::ios::in | std::ios::binary);
+	MappedFile imgFile(filename);
 	if (!imgFile)
 	{
 		throw Exception(filename + " not found");
 	}
 
-	imgFile.seekg(0, std::ios::end);
-	std::streamoff size = imgFile.tellg();
-	imgFile.seekg(0, std::ios::beg);
+	const Uint8 *data = imgFile.getData();
+	int nframes = (int)(imgFile.getSize() / (_width * _height));
 
-	nframes = (int)size / (_width * _height);
-
-	for (int i = 0; i < nframes; ++i)
+	for (int frame = 0; frame < nframes; ++frame)
 	{
 		Surface *surface = new Surface(_width, _height);
-		_frames[i] = surface;
-	}
-
-	Uint8 value;
-	int x = 0, y = 0, frame = 0;
-
-	// Lock the surface
-	_frames[frame]->lock();
-
-	while (imgFile.read((char*)&value, 1))
-	{
-		_frames[frame]->setPixelIterative(&x, &y, value);
+		_frames[frame] = surface;
 
-		if (y >= _height)
+		// Lock the surface
+		surface->lock();
+		Uint8 *row = (Uint8*)surface->getSurface()->pixels;
+		for (int y = 0; y < _height; ++y, data += _width, row += surface->getSurface()->pitch)
 		{
-			// Unlock the surface
-			_frames[frame]->unlock();
-
-			frame++;
-			x = 0;
-			y = 0;
-
-			if (frame >= nframes)
-				break;
-			else
-				_frames[frame]->lock();
+			memcpy(row, data, _width);
 		}
+		// Unlock the surface
+		surface->unlock();
 	}
-
-	imgFile.close();
 }
 
 /**
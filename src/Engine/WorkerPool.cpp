@@ -0,0 +1,137 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "WorkerPool.h"
+#include <algorithm>
+#include <vector>
+#include "CrossPlatform.h"
+#include "Options.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Initializes a batch of jobs.
+ * @param job Function to run for each job.
+ * @param data Data passed to every job.
+ * @param count Number of jobs in the batch.
+ */
+WorkerPool::WorkerPool(Job job, void *data, size_t count) : _job(job), _data(data), _count(count), _next(0)
+{
+	_mutex = SDL_CreateMutex();
+}
+
+/**
+ *
+ */
+WorkerPool::~WorkerPool()
+{
+	SDL_DestroyMutex(_mutex);
+}
+
+/**
+ * Hands out the next unclaimed job of the batch.
+ * @param index Pointer to store the job index.
+ * @return False if there's no jobs left.
+ */
+bool WorkerPool::nextJob(size_t *index)
+{
+	SDL_LockMutex(_mutex);
+	bool available = _next < _count;
+	if (available)
+	{
+		*index = _next++;
+	}
+	SDL_UnlockMutex(_mutex);
+	return available;
+}
+
+/**
+ * Keeps claiming and running jobs until there's none left.
+ * @param pool_ptr Pointer to the batch.
+ * @return Always zero.
+ */
+int WorkerPool::work(void *pool_ptr)
+{
+	WorkerPool *pool = (WorkerPool*)pool_ptr;
+	size_t index;
+	while (pool->nextJob(&index))
+	{
+		pool->_job(pool->_data, index);
+	}
+	return 0;
+}
+
+/**
+ * Gets the number of threads (including the calling one)
+ * batches are spread across. Can be forced through the options,
+ * otherwise it matches the number of available cores.
+ * @return Number of threads.
+ */
+int WorkerPool::getThreadCount()
+{
+	if (Options::workerThreads > 0)
+	{
+		return Options::workerThreads;
+	}
+	return std::max(1, CrossPlatform::getNumberOfCores());
+}
+
+/**
+ * Runs a job for every index of a batch, spread across the
+ * available worker threads, and waits for all of them to finish.
+ * The calling thread takes part in the work too, so if no
+ * threads can be created the batch simply runs sequentially.
+ * @param job Function to run for each job.
+ * @param data Data passed to every job.
+ * @param count Number of jobs in the batch.
+ */
+void WorkerPool::run(Job job, void *data, size_t count)
+{
+	if (count == 0)
+	{
+		return;
+	}
+	WorkerPool pool(job, data, count);
+	if (pool._mutex == 0)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			job(data, i);
+		}
+		return;
+	}
+	size_t threads = std::min((size_t)getThreadCount(), count);
+	std::vector<SDL_Thread*> workers;
+	for (size_t i = 1; i < threads; ++i)
+	{
+		SDL_Thread *thread = SDL_CreateThread(work, (void*)&pool);
+		if (thread == 0)
+		{
+			break;
+		}
+		workers.push_back(thread);
+	}
+	work((void*)&pool);
+	for (std::vector<SDL_Thread*>::iterator i = workers.begin(); i != workers.end(); ++i)
+	{
+		SDL_WaitThread(*i, 0);
+	}
+}
+
+}
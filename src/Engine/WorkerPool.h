@@ -0,0 +1,57 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <SDL.h>
+#include <SDL_thread.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Runs batches of independent jobs across a number of worker
+ * threads, blocking the caller until the whole batch is done.
+ * Jobs are only handed an index, so they must not touch any
+ * state shared with other jobs, and must not throw.
+ */
+class WorkerPool
+{
+public:
+	/// Function called for each job in a batch.
+	typedef void (*Job)(void *data, size_t index);
+private:
+	Job _job;
+	void *_data;
+	size_t _count, _next;
+	SDL_mutex *_mutex;
+	/// Creates a batch of jobs.
+	WorkerPool(Job job, void *data, size_t count);
+	/// Cleans up the batch.
+	~WorkerPool();
+	/// Gets the index of the next job to run.
+	bool nextJob(size_t *index);
+	/// Runs jobs until the batch is exhausted.
+	static int work(void *pool_ptr);
+public:
+	/// Gets the number of threads used to run batches.
+	static int getThreadCount();
+	/// Runs a job for every index in a batch.
+	static void run(Job job, void *data, size_t count);
+};
+
+}
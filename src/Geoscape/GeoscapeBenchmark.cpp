@@ -0,0 +1,132 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "GeoscapeBenchmark.h"
+#include "GeoscapeState.h"
+#include "../Engine/Game.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Options.h"
+#include "../Engine/Logger.h"
+#include "../Savegame/SavedGame.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Initializes all the timings.
+ * @param game Pointer to the core game.
+ */
+GeoscapeBenchmark::GeoscapeBenchmark(Game *game) : _game(game), _geoscape(0), _report("geoscape"), _skipped(0), _days(0)
+{
+}
+
+/**
+ *
+ */
+GeoscapeBenchmark::~GeoscapeBenchmark()
+{
+
+}
+
+/**
+ * Loads the active mods the same way the start screen does,
+ * and then the saved game on top of them. The Geoscape
+ * is owned by the game like any other state.
+ * @param filename Filename of the save, relative to the user folder.
+ */
+void GeoscapeBenchmark::load(const std::string &filename)
+{
+	Log(LOG_INFO) << "Loading data...";
+	Options::updateMods();
+	Uint64 start = CrossPlatform::getMicroseconds();
+	_game->loadMods();
+	_report.addTime("Mod::loadAll", CrossPlatform::getMicroseconds() - start);
+	_game->defaultLanguage();
+	Log(LOG_INFO) << "Loading saved game: " << filename;
+	SavedGame *save = new SavedGame();
+	try
+	{
+		start = CrossPlatform::getMicroseconds();
+		save->load(filename, _game->getMod());
+		_report.addTime("SavedGame::load", CrossPlatform::getMicroseconds() - start);
+	}
+	catch (...)
+	{
+		delete save;
+		throw;
+	}
+	_game->setSavedGame(save);
+	_geoscape = new GeoscapeState;
+	_geoscape->setTriggerReport(&_report);
+	_game->setState(_geoscape);
+}
+
+/**
+ * Advances the game time like the Geoscape does at full speed,
+ * except nothing stops it: popups are never shown and dogfights
+ * never start, so the player can't react to anything.
+ * @param days Number of game days to run for.
+ */
+void GeoscapeBenchmark::run(int days)
+{
+	SavedGame *save = _game->getSavedGame();
+	Log(LOG_INFO) << "Running Geoscape for " << days << " days...";
+	Uint64 start = CrossPlatform::getMicroseconds();
+	int idleTicks = 0, skippedTicks = 0;
+	while (_days < days && save->getEnding() == END_NONE)
+	{
+		TimeTrigger next;
+		if (!_geoscape->timeStep(idleTicks, skippedTicks, next))
+		{
+			_skipped++;
+			continue;
+		}
+		if (next >= TIME_1DAY)
+		{
+			_days++;
+		}
+	}
+	_geoscape->skipIdleTicks(skippedTicks);
+	_report.setValue("days", _days);
+	_report.setValue("skipped", _skipped);
+	_report.setValue("total", CrossPlatform::getMicroseconds() - start);
+	if (save->getEnding() != END_NONE)
+	{
+		Log(LOG_WARNING) << "Game ended after " << _days << " days.";
+	}
+}
+
+/**
+ * Reports the time spent in each trigger, both to
+ * the standard output and the log.
+ */
+void GeoscapeBenchmark::report() const
+{
+	_report.print();
+}
+
+/**
+ * Saves the time spent in each trigger as JSON.
+ * @param filename Full path of the file.
+ */
+void GeoscapeBenchmark::save(const std::string &filename) const
+{
+	_report.save(filename);
+}
+
+}
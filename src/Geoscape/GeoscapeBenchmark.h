@@ -0,0 +1,57 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include "../Engine/BenchmarkReport.h"
+
+namespace OpenXcom
+{
+
+class Game;
+class GeoscapeState;
+
+/**
+ * Runs the Geoscape time logic on a saved game without any
+ * player interaction and reports how long each time trigger takes.
+ * Meant to be run from the command line with no display, to compare
+ * the performance of builds and mods.
+ */
+class GeoscapeBenchmark
+{
+private:
+	Game *_game;
+	GeoscapeState *_geoscape;
+	BenchmarkReport _report;
+	int _skipped, _days;
+public:
+	/// Creates a benchmark for the game.
+	GeoscapeBenchmark(Game *game);
+	/// Cleans up the benchmark.
+	~GeoscapeBenchmark();
+	/// Loads the game data and the saved game.
+	void load(const std::string &filename);
+	/// Advances the game time.
+	void run(int days);
+	/// Logs the timings.
+	void report() const;
+	/// Saves the timings.
+	void save(const std::string &filename) const;
+};
+
+}
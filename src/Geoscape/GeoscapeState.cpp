@@ -21,6 +21,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <functional>
+#include <climits>
 #include "../Engine/RNG.h"
 #include "../Engine/Game.h"
 #include "../Engine/Action.h"
@@ -33,6 +34,9 @@
 #include "../Interface/Text.h"
 #include "../Interface/TextButton.h"
 #include "../Engine/Timer.h"
+#include "../Engine/Profiler.h"
+#include "../Engine/BenchmarkReport.h"
+#include "../Engine/CrossPlatform.h"
 #include "../Savegame/GameTime.h"
 #include "../Savegame/SavedGame.h"
 #include "../Savegame/Base.h"
@@ -112,7 +116,7 @@ namespace OpenXcom
  * Initializes all the elements in the Geoscape screen.
  * @param game Pointer to the core game.
  */
-GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _minimizedDogfights(0)
+GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _minimizedDogfights(0), _triggerReport(0)
 {
 	int screenWidth = Options::baseXGeoscape;
 	int screenHeight = Options::baseYGeoscape;
@@ -629,6 +633,7 @@ void GeoscapeState::timeDisplay()
  */
 void GeoscapeState::timeAdvance()
 {
+	Profiler::Scope profile("GeoscapeState::timeAdvance");
 	int timeSpan = 0;
 	if (_timeSpeed == _btn5Secs)
 	{
@@ -655,26 +660,13 @@ void GeoscapeState::timeAdvance()
 		timeSpan = 12 * 5 * 6 * 2 * 24;
 	}
 
+	int idleTicks = 0, skippedTicks = 0;
 	for (int i = 0; i < timeSpan && !_pause; ++i)
 	{
 		TimeTrigger trigger;
-		trigger = _game->getSavedGame()->getTime()->advance();
-		switch (trigger)
-		{
-		case TIME_1MONTH:
-			time1Month();
-		case TIME_1DAY:
-			time1Day();
-		case TIME_1HOUR:
-			time1Hour();
-		case TIME_30MIN:
-			time30Minutes();
-		case TIME_10MIN:
-			time10Minutes();
-		case TIME_5SEC:
-			time5Seconds();
-		}
+		timeStep(idleTicks, skippedTicks, trigger);
 	}
+	skipIdleTicks(skippedTicks);
 
 	_pause = !_dogfightsToBeStarted.empty();
 
@@ -682,12 +674,160 @@ void GeoscapeState::timeAdvance()
 	_globe->draw();
 }
 
+/**
+ * Advances the game time by 5 seconds and runs all the triggers
+ * that are due, biggest first. Most 5 second triggers at high speeds
+ * have nothing to move, so they're skipped until something bigger
+ * comes along; call skipIdleTicks() with the skipped count when done.
+ * @param idleTicks Number of 5 second triggers that can still be skipped.
+ * @param skippedTicks Number of 5 second triggers skipped so far.
+ * @param trigger Returns the biggest trigger that was due.
+ * @return False if the step was skipped.
+ */
+bool GeoscapeState::timeStep(int &idleTicks, int &skippedTicks, TimeTrigger &trigger)
+{
+	trigger = _game->getSavedGame()->getTime()->advance();
+	if (trigger == TIME_5SEC && idleTicks > 0)
+	{
+		idleTicks--;
+		skippedTicks++;
+		return false;
+	}
+	skipIdleTicks(skippedTicks);
+	skippedTicks = 0;
+	for (int i = trigger; i >= TIME_5SEC; --i)
+	{
+		runTrigger((TimeTrigger)i);
+	}
+	idleTicks = getIdleTicks();
+	return true;
+}
+
+/**
+ * Runs a single time trigger, timing it if there's a report.
+ * @param trigger Time trigger.
+ */
+void GeoscapeState::runTrigger(TimeTrigger trigger)
+{
+	static const char *names[] = { "time5Seconds", "time10Minutes", "time30Minutes", "time1Hour", "time1Day", "time1Month" };
+	Uint64 start = _triggerReport ? CrossPlatform::getMicroseconds() : 0;
+	switch (trigger)
+	{
+	case TIME_1MONTH:
+		time1Month();
+		break;
+	case TIME_1DAY:
+		time1Day();
+		break;
+	case TIME_1HOUR:
+		time1Hour();
+		break;
+	case TIME_30MIN:
+		time30Minutes();
+		break;
+	case TIME_10MIN:
+		time10Minutes();
+		break;
+	case TIME_5SEC:
+		time5Seconds();
+		break;
+	}
+	if (_triggerReport)
+	{
+		_triggerReport->addTime(names[trigger], CrossPlatform::getMicroseconds() - start);
+	}
+}
+
+/**
+ * Sets a report to add the time spent in each trigger to,
+ * for benchmarking.
+ * @param report Pointer to the report, or NULL for none.
+ */
+void GeoscapeState::setTriggerReport(BenchmarkReport *report)
+{
+	_triggerReport = report;
+}
+
+/**
+ * Checks how many of the following 5 second triggers would
+ * do nothing but count down landed UFOs. This is the case when
+ * nothing is moving and there's nothing left to clean up, since
+ * only the bigger triggers can change that.
+ * @return Number of triggers that can be skipped.
+ */
+int GeoscapeState::getIdleTicks() const
+{
+	SavedGame *save = _game->getSavedGame();
+	if (save->getBases()->empty() || save->getEnding() == END_LOSE)
+	{
+		return 0;
+	}
+	int ticks = INT_MAX;
+	for (std::vector<Ufo*>::const_iterator i = save->getUfos()->begin(); i != save->getUfos()->end(); ++i)
+	{
+		switch ((*i)->getStatus())
+		{
+		case Ufo::LANDED:
+			// stop right before it lifts off
+			ticks = std::min(ticks, (int)(*i)->getSecondsRemaining() / 5 - 1);
+			break;
+		case Ufo::CRASHED:
+			if (!(*i)->getDetected() || (*i)->getSecondsRemaining() == 0)
+			{
+				return 0;
+			}
+			break;
+		default:
+			return 0;
+		}
+	}
+	for (std::vector<Base*>::const_iterator i = save->getBases()->begin(); i != save->getBases()->end(); ++i)
+	{
+		for (std::vector<Craft*>::const_iterator j = (*i)->getCrafts()->begin(); j != (*i)->getCrafts()->end(); ++j)
+		{
+			if (!(*j)->isStationary())
+			{
+				return 0;
+			}
+		}
+	}
+	for (std::vector<Waypoint*>::const_iterator i = save->getWaypoints()->begin(); i != save->getWaypoints()->end(); ++i)
+	{
+		if ((*i)->getFollowers()->empty())
+		{
+			return 0;
+		}
+	}
+	return std::max(ticks, 0);
+}
+
+/**
+ * Catches up on skipped 5 second triggers, which
+ * only leaves the landed UFOs to count down.
+ * @param ticks Number of triggers skipped.
+ */
+void GeoscapeState::skipIdleTicks(int ticks)
+{
+	if (ticks == 0)
+	{
+		return;
+	}
+	for (std::vector<Ufo*>::iterator i = _game->getSavedGame()->getUfos()->begin(); i != _game->getSavedGame()->getUfos()->end(); ++i)
+	{
+		if ((*i)->getStatus() == Ufo::LANDED)
+		{
+			(*i)->setSecondsRemaining((*i)->getSecondsRemaining() - ticks * 5);
+		}
+	}
+}
+
 /**
  * Takes care of any game logic that has to
  * run every game second, like craft movement.
  */
 void GeoscapeState::time5Seconds()
 {
+	Profiler::Scope profile("GeoscapeState::time5Seconds");
 	// Game over if there are no more bases.
 	if (_game->getSavedGame()->getBases()->empty())
 	{
@@ -785,21 +925,13 @@ void GeoscapeState::time5Seconds()
 		{
 			if ((*j)->isDestroyed())
 			{
-				for (std::vector<Country*>::iterator country = _game->getSavedGame()->getCountries()->begin(); country != _game->getSavedGame()->getCountries()->end(); ++country)
+				if (Country *country = _game->getSavedGame()->locateCountry((*j)->getLongitude(), (*j)->getLatitude()))
 				{
-					if ((*country)->getRules()->insideCountry((*j)->getLongitude(), (*j)->getLatitude()))
-					{
-						(*country)->addActivityXcom(-(*j)->getRules()->getScore());
-						break;
-					}
+					country->addActivityXcom(-(*j)->getRules()->getScore());
 				}
-				for (std::vector<Region*>::iterator region = _game->getSavedGame()->getRegions()->begin(); region != _game->getSavedGame()->getRegions()->end(); ++region)
+				if (Region *region = _game->getSavedGame()->locateRegion((*j)->getLongitude(), (*j)->getLatitude()))
 				{
-					if ((*region)->getRules()->insideRegion((*j)->getLongitude(), (*j)->getLatitude()))
-					{
-						(*region)->addActivityXcom(-(*j)->getRules()->getScore());
-						break;
-					}
+					region->addActivityXcom(-(*j)->getRules()->getScore());
 				}
 				// if a transport craft has been shot down, kill all the soldiers on board.
 				if ((*j)->getRules()->getSoldiers() > 0)
@@ -1064,12 +1196,13 @@ struct SetRetaliationTarget: public std::unary_function<std::map<const Region *,
  */
 void GeoscapeState::time10Minutes()
 {
+	Profiler::Scope profile("GeoscapeState::time10Minutes");
 	for (std::vector<Base*>::iterator i = _game->getSavedGame()->getBases()->begin(); i != _game->getSavedGame()->getBases()->end(); ++i)
 	{
 		// Fuel consumption for XCOM craft.
 		for (std::vector<Craft*>::iterator j = (*i)->getCrafts()->begin(); j != (*i)->getCrafts()->end(); ++j)
 		{
-			if ((*j)->getStatus() == "STR_OUT")
+			if ((*j)->getStatus() == CRAFT_OUT)
 			{
 				(*j)->consumeFuel();
 				if (!(*j)->getLowFuel() && (*j)->getFuel() <= (*j)->getFuelLimit())
@@ -1171,13 +1304,9 @@ bool GeoscapeState::processMissionSite(MissionSite *site) const
 	{
 		region->addActivityAlien(score);
 	}
-	for (std::vector<Country*>::iterator k = _game->getSavedGame()->getCountries()->begin(); k != _game->getSavedGame()->getCountries()->end(); ++k)
+	if (Country *country = _game->getSavedGame()->locateCountry(site->getLongitude(), site->getLatitude()))
 	{
-		if ((*k)->getRules()->insideCountry(site->getLongitude(), site->getLatitude()))
-		{
-			(*k)->addActivityAlien(score);
-			break;
-		}
+		country->addActivityAlien(score);
 	}
 	if (!removeSite)
 	{
@@ -1214,6 +1343,7 @@ struct expireCrashedUfo: public std::unary_function<Ufo*, void>
  */
 void GeoscapeState::time30Minutes()
 {
+	Profiler::Scope profile("GeoscapeState::time30Minutes");
 	// Decrease mission countdowns
 	std::for_each(_game->getSavedGame()->getAlienMissions().begin(),
 			  _game->getSavedGame()->getAlienMissions().end(),
@@ -1244,7 +1374,7 @@ void GeoscapeState::time30Minutes()
 	{
 		for (std::vector<Craft*>::iterator j = (*i)->getCrafts()->begin(); j != (*i)->getCrafts()->end(); ++j)
 		{
-			if ((*j)->getStatus() == "STR_REFUELLING")
+			if ((*j)->getStatus() == CRAFT_REFUELLING)
 			{
 				std::string item = (*j)->getRules()->getRefuelItem();
 				if (item.empty())
@@ -1268,7 +1398,7 @@ void GeoscapeState::time30Minutes()
 						popup(new CraftErrorState(this, msg));
 						if ((*j)->getFuel() > 0)
 						{
-							(*j)->setStatus("STR_READY");
+							(*j)->setStatus(CRAFT_READY);
 						}
 						else
 						{
@@ -1281,6 +1411,13 @@ void GeoscapeState::time30Minutes()
 	}
 
 	// Handle UFO detection and give aliens points
+	// (radars can't change in the meantime, so look up their ranges once)
+	std::vector<Base*> *bases = _game->getSavedGame()->getBases();
+	std::vector<int> radarRanges;
+	for (std::vector<Base*>::const_iterator b = bases->begin(); b != bases->end(); ++b)
+	{
+		radarRanges.push_back((*b)->getRadarRange());
+	}
 	for (std::vector<Ufo*>::iterator u = _game->getSavedGame()->getUfos()->begin(); u != _game->getSavedGame()->getUfos()->end(); ++u)
 	{
 		int points = (*u)->getRules()->getMissionScore(); //one point per UFO in-flight per half hour
@@ -1290,39 +1427,35 @@ void GeoscapeState::time30Minutes()
 			points *= 2;
 		case Ufo::FLYING:
 			// Get area
-			for (std::vector<Region*>::iterator k = _game->getSavedGame()->getRegions()->begin(); k != _game->getSavedGame()->getRegions()->end(); ++k)
+			if (Region *region = _game->getSavedGame()->locateRegion((*u)->getLongitude(), (*u)->getLatitude()))
 			{
-				if ((*k)->getRules()->insideRegion((*u)->getLongitude(), (*u)->getLatitude()))
-				{
-					(*k)->addActivityAlien(points);
-					break;
-				}
+				region->addActivityAlien(points);
 			}
 			// Get country
-			for (std::vector<Country*>::iterator k = _game->getSavedGame()->getCountries()->begin(); k != _game->getSavedGame()->getCountries()->end(); ++k)
+			if (Country *country = _game->getSavedGame()->locateCountry((*u)->getLongitude(), (*u)->getLatitude()))
 			{
-				if ((*k)->getRules()->insideCountry((*u)->getLongitude(), (*u)->getLatitude()))
-				{
-					(*k)->addActivityAlien(points);
-					break;
-				}
+				country->addActivityAlien(points);
 			}
 			if (!(*u)->getDetected())
 			{
 				bool detected = false, hyperdetected = false;
-				for (std::vector<Base*>::iterator b = _game->getSavedGame()->getBases()->begin(); !hyperdetected && b != _game->getSavedGame()->getBases()->end(); ++b)
+				for (std::vector<Base*>::iterator b = bases->begin(); !hyperdetected && b != bases->end(); ++b)
 				{
-					switch ((*b)->detect(*u))
+					// out of range of every radar, no need to roll for each of them
+					if (radarRanges[b - bases->begin()] >= (*b)->getDistance(*u) * 60.0 * (180.0 / M_PI))
 					{
-					case 2:	// hyper-wave decoder
-						(*u)->setHyperDetected(true);
-						hyperdetected = true;
-					case 1: // conventional radar
-						detected = true;
+						switch ((*b)->detect(*u))
+						{
+						case 2:	// hyper-wave decoder
+							(*u)->setHyperDetected(true);
+							hyperdetected = true;
+						case 1: // conventional radar
+							detected = true;
+						}
 					}
 					for (std::vector<Craft*>::iterator c = (*b)->getCrafts()->begin(); !detected && c != (*b)->getCrafts()->end(); ++c)
 					{
-						if ((*c)->getStatus() == "STR_OUT" && (*c)->detect(*u))
+						if ((*c)->getStatus() == CRAFT_OUT && (*c)->detect(*u))
 						{
 							detected = true;
 							break;
@@ -1338,22 +1471,25 @@ void GeoscapeState::time30Minutes()
 			else
 			{
 				bool detected = false, hyperdetected = false;
-				for (std::vector<Base*>::iterator b = _game->getSavedGame()->getBases()->begin(); !hyperdetected && b != _game->getSavedGame()->getBases()->end(); ++b)
+				for (std::vector<Base*>::iterator b = bases->begin(); !hyperdetected && b != bases->end(); ++b)
 				{
-					switch ((*b)->insideRadarRange(*u))
+					if (radarRanges[b - bases->begin()] >= (*b)->getDistance(*u) * 60.0 * (180.0 / M_PI))
 					{
-					case 2:	// hyper-wave decoder
-						detected = true;
-						hyperdetected = true;
-						(*u)->setHyperDetected(true);
-						break;
-					case 1: // conventional radar
-						detected = true;
-						hyperdetected = (*u)->getHyperDetected();
+						switch ((*b)->insideRadarRange(*u))
+						{
+						case 2:	// hyper-wave decoder
+							detected = true;
+							hyperdetected = true;
+							(*u)->setHyperDetected(true);
+							break;
+						case 1: // conventional radar
+							detected = true;
+							hyperdetected = (*u)->getHyperDetected();
+						}
 					}
 					for (std::vector<Craft*>::iterator c = (*b)->getCrafts()->begin(); !detected && c != (*b)->getCrafts()->end(); ++c)
 					{
-						if ((*c)->getStatus() == "STR_OUT" && (*c)->insideRadarRange(*u))
+						if ((*c)->getStatus() == CRAFT_OUT && (*c)->insideRadarRange(*u))
 						{
 							detected = true;
 							hyperdetected = (*u)->getHyperDetected();
@@ -1398,16 +1534,17 @@ void GeoscapeState::time30Minutes()
  */
 void GeoscapeState::time1Hour()
 {
+	Profiler::Scope profile("GeoscapeState::time1Hour");
 	// Handle craft maintenance
 	for (std::vector<Base*>::iterator i = _game->getSavedGame()->getBases()->begin(); i != _game->getSavedGame()->getBases()->end(); ++i)
 	{
 		for (std::vector<Craft*>::iterator j = (*i)->getCrafts()->begin(); j != (*i)->getCrafts()->end(); ++j)
 		{
-			if ((*j)->getStatus() == "STR_REPAIRS")
+			if ((*j)->getStatus() == CRAFT_REPAIRS)
 			{
 				(*j)->repair();
 			}
-			else if ((*j)->getStatus() == "STR_REARMING")
+			else if ((*j)->getStatus() == CRAFT_REARMING)
 			{
 				std::string s = (*j)->rearm(_game->getMod());
 				if (!s.empty())
@@ -1523,6 +1660,7 @@ void GenerateSupplyMission::operator()(const AlienBase *base) const
  */
 void GeoscapeState::time1Day()
 {
+	Profiler::Scope profile("GeoscapeState::time1Day");
 	for (std::vector<Base*>::iterator i = _game->getSavedGame()->getBases()->begin(); i != _game->getSavedGame()->getBases()->end(); ++i)
 	{
 		// Handle facility construction
@@ -1670,21 +1808,13 @@ void GeoscapeState::time1Day()
 	// handle regional and country points for alien bases
 	for (std::vector<AlienBase*>::const_iterator b = _game->getSavedGame()->getAlienBases()->begin(); b != _game->getSavedGame()->getAlienBases()->end(); ++b)
 	{
-		for (std::vector<Region*>::iterator k = _game->getSavedGame()->getRegions()->begin(); k != _game->getSavedGame()->getRegions()->end(); ++k)
+		if (Region *region = _game->getSavedGame()->locateRegion((*b)->getLongitude(), (*b)->getLatitude()))
 		{
-			if ((*k)->getRules()->insideRegion((*b)->getLongitude(), (*b)->getLatitude()))
-			{
-				(*k)->addActivityAlien((*b)->getDeployment()->getPoints());
-				break;
-			}
+			region->addActivityAlien((*b)->getDeployment()->getPoints());
 		}
-		for (std::vector<Country*>::iterator k = _game->getSavedGame()->getCountries()->begin(); k != _game->getSavedGame()->getCountries()->end(); ++k)
+		if (Country *country = _game->getSavedGame()->locateCountry((*b)->getLongitude(), (*b)->getLatitude()))
 		{
-			if ((*k)->getRules()->insideCountry((*b)->getLongitude(), (*b)->getLatitude()))
-			{
-				(*k)->addActivityAlien((*b)->getDeployment()->getPoints());
-				break;
-			}
+			country->addActivityAlien((*b)->getDeployment()->getPoints());
 		}
 	}
 
@@ -1713,6 +1843,7 @@ void GeoscapeState::time1Day()
  */
 void GeoscapeState::time1Month()
 {
+	Profiler::Scope profile("GeoscapeState::time1Month");
 	_game->getSavedGame()->addMonth();
 
 	// Determine alien mission for this month.
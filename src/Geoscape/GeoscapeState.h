@@ -19,6 +19,7 @@
  */
 #include "../Engine/State.h"
 #include <list>
+#include "../Savegame/GameTime.h"
 
 namespace OpenXcom
 {
@@ -34,6 +35,7 @@ class Ufo;
 class MissionSite;
 class Base;
 class RuleMissionScript;
+class BenchmarkReport;
 
 /**
  * Geoscape screen which shows an overview of
@@ -56,6 +58,9 @@ private:
 	std::list<State*> _popups;
 	std::list<DogfightState*> _dogfights, _dogfightsToBeStarted;
 	size_t _minimizedDogfights;
+	BenchmarkReport *_triggerReport;
+	/// Runs a single time trigger.
+	void runTrigger(TimeTrigger trigger);
 public:
 	/// Creates the Geoscape state.
 	GeoscapeState();
@@ -71,6 +76,14 @@ public:
 	void timeDisplay();
 	/// Advances the game timer.
 	void timeAdvance();
+	/// Advances the game time by one step.
+	bool timeStep(int &idleTicks, int &skippedTicks, TimeTrigger &trigger);
+	/// Sets the report to time the triggers in.
+	void setTriggerReport(BenchmarkReport *report);
+	/// Gets how many 5 second triggers can be skipped.
+	int getIdleTicks() const;
+	/// Skips 5 second triggers where nothing happens.
+	void skipIdleTicks(int ticks);
 	/// Trigger whenever 5 seconds pass.
 	void time5Seconds();
 	/// Trigger whenever 10 minutes pass.
@@ -1125,7 +1125,7 @@ void Globe::drawRadars()
 
 		for (std::vector<Craft*>::iterator j = (*i)->getCrafts()->begin(); j != (*i)->getCrafts()->end(); ++j)
 		{
-			if ((*j)->getStatus()!= "STR_OUT")
+			if ((*j)->getStatus() != CRAFT_OUT)
 				continue;
 			lat=(*j)->getLatitude();
 			lon=(*j)->getLongitude();
@@ -1476,7 +1476,7 @@ void Globe::drawFlights()
 		for (std::vector<Craft*>::iterator j = (*i)->getCrafts()->begin(); j != (*i)->getCrafts()->end(); ++j)
 		{
 			// Hide crafts docked at base
-			if ((*j)->getStatus() != "STR_OUT" || (*j)->getDestination() == 0 /*|| pointBack((*j)->getLongitude(), (*j)->getLatitude())*/)
+			if ((*j)->getStatus() != CRAFT_OUT || (*j)->getDestination() == 0 /*|| pointBack((*j)->getLongitude(), (*j)->getLatitude())*/)
 				continue;
 
 			double lon1 = (*j)->getLongitude();
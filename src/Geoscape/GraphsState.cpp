@@ -621,6 +621,29 @@ void GraphsState::updateScale(double lowerLimit, double upperLimit)
 	}
 }
 
+/**
+ * Checks if a line needs to be drawn for the given scale.
+ * The history can't change while the graphs are open, so a line
+ * only has to be redrawn when the scale changes, toggling a line
+ * just shows or hides what's already there.
+ * @param line Surface holding the line.
+ * @param lowerLimit Minimum value of the scale.
+ * @param upperLimit Maximum value of the scale.
+ * @return True if the line was cleared and has to be drawn.
+ */
+bool GraphsState::prepareLine(Surface *line, int lowerLimit, int upperLimit)
+{
+	std::pair<int, int> scale = std::make_pair(lowerLimit, upperLimit);
+	std::map<Surface *, std::pair<int, int> >::iterator i = _lineScales.find(line);
+	if (i != _lineScales.end() && i->second == scale)
+	{
+		return false;
+	}
+	_lineScales[line] = scale;
+	line->clear();
+	return true;
+}
+
 /**
  * instead of having all our line drawing in one giant ridiculous routine, just use the one we need.
  */
@@ -724,9 +747,8 @@ void GraphsState::drawCountryLines()
 	for (size_t entry = 0; entry != _game->getSavedGame()->getCountries()->size(); ++entry)
 	{
 		Country *country = _game->getSavedGame()->getCountries()->at(entry);
-		_alienCountryLines.at(entry)->clear();
-		_xcomCountryLines.at(entry)->clear();
-		_incomeLines.at(entry)->clear();
+		Surface *line = _alien ? _alienCountryLines.at(entry) : _income ? _incomeLines.at(entry) : _xcomCountryLines.at(entry);
+		bool redraw = prepareLine(line, lowerLimit, upperLimit);
 		std::vector<Sint16> newLineVector;
 		int reduction = 0;
 		for (size_t iter = 0; iter != 12; ++iter)
@@ -763,31 +785,18 @@ void GraphsState::drawCountryLines()
 			if (y >=175)
 				y = 175;
 			newLineVector.push_back(y);
-			if (newLineVector.size() > 1 && _alien)
-				_alienCountryLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _countryToggles.at(entry)->_color+4);
-			else if (newLineVector.size() > 1 && _income)
-				_incomeLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _countryToggles.at(entry)->_color+4);
-			else if (newLineVector.size() > 1)
-				_xcomCountryLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _countryToggles.at(entry)->_color+4);
+			if (redraw && newLineVector.size() > 1)
+				line->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _countryToggles.at(entry)->_color+4);
 			}
-		if (_alien)
-			_alienCountryLines.at(entry)->setVisible(_countryToggles.at(entry)->_pushed);
-		else if (_income)
-			_incomeLines.at(entry)->setVisible(_countryToggles.at(entry)->_pushed);
-		else
-			_xcomCountryLines.at(entry)->setVisible(_countryToggles.at(entry)->_pushed);
+		line->setVisible(_countryToggles.at(entry)->_pushed);
 	}
-	if (_alien)
-		_alienCountryLines.back()->clear();
-	else if (_income)
-		_incomeLines.back()->clear();
-	else
-		_xcomCountryLines.back()->clear();
 
 	// set up the "total" line
+	Surface *totalLine = _alien ? _alienCountryLines.back() : _income ? _incomeLines.back() : _xcomCountryLines.back();
+	bool redrawTotal = prepareLine(totalLine, lowerLimit, upperLimit);
 	std::vector<Sint16> newLineVector;
 	Uint8 color = _game->getMod()->getInterface("graphs")->getElement("countryTotal")->color2;
-	for (int iter = 0; iter != 12; ++iter)
+	for (int iter = 0; iter != 12 && redrawTotal; ++iter)
 	{
 		int x = 312 - (iter*17);
 		int y = 175 - (-lowerLimit / units);
@@ -798,21 +807,9 @@ void GraphsState::drawCountryLines()
 		}
 		newLineVector.push_back(y);
 		if (newLineVector.size() > 1)
-		{
-			if (_alien)
-				_alienCountryLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
-			else if (_income)
-				_incomeLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
-			else
-				_xcomCountryLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
-		}
+			totalLine->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
 	}
-	if (_alien)
-		_alienCountryLines.back()->setVisible(_countryToggles.back()->_pushed);
-	else if (_income)
-		_incomeLines.back()->setVisible(_countryToggles.back()->_pushed);
-	else
-		_xcomCountryLines.back()->setVisible(_countryToggles.back()->_pushed);
+	totalLine->setVisible(_countryToggles.back()->_pushed);
 	updateScale(lowerLimit, upperLimit);
 	_txtFactor->setVisible(_income);
 }
@@ -891,8 +888,8 @@ void GraphsState::drawRegionLines()
 	for (size_t entry = 0; entry != _game->getSavedGame()->getRegions()->size(); ++entry)
 	{
 		Region *region = _game->getSavedGame()->getRegions()->at(entry);
-		_alienRegionLines.at(entry)->clear();
-		_xcomRegionLines.at(entry)->clear();
+		Surface *line = _alien ? _alienRegionLines.at(entry) : _xcomRegionLines.at(entry);
+		bool redraw = prepareLine(line, lowerLimit, upperLimit);
 		std::vector<Sint16> newLineVector;
 		int reduction = 0;
 		for (size_t iter = 0; iter != 12; ++iter)
@@ -920,27 +917,20 @@ void GraphsState::drawRegionLines()
 			if (y >=175)
 				y = 175;
 			newLineVector.push_back(y);
-			if (newLineVector.size() > 1 && _alien)
-				_alienRegionLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _regionToggles.at(entry)->_color+4);
-			else if (newLineVector.size() > 1)
-				_xcomRegionLines.at(entry)->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _regionToggles.at(entry)->_color+4);
+			if (redraw && newLineVector.size() > 1)
+				line->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), _regionToggles.at(entry)->_color+4);
 		}
 
-		if (_alien)
-			_alienRegionLines.at(entry)->setVisible(_regionToggles.at(entry)->_pushed);
-		else
-			_xcomRegionLines.at(entry)->setVisible(_regionToggles.at(entry)->_pushed);
+		line->setVisible(_regionToggles.at(entry)->_pushed);
 	}
 
 	// set up the "total" line
-	if (_alien)
-		_alienRegionLines.back()->clear();
-	else
-		_xcomRegionLines.back()->clear();
+	Surface *totalLine = _alien ? _alienRegionLines.back() : _xcomRegionLines.back();
+	bool redrawTotal = prepareLine(totalLine, lowerLimit, upperLimit);
 
 	Uint8 color = _game->getMod()->getInterface("graphs")->getElement("regionTotal")->color2;
 	std::vector<Sint16> newLineVector;
-	for (int iter = 0; iter != 12; ++iter)
+	for (int iter = 0; iter != 12 && redrawTotal; ++iter)
 	{
 		int x = 312 - (iter*17);
 		int y = 175 - (-lowerLimit / units);
@@ -951,17 +941,9 @@ void GraphsState::drawRegionLines()
 		}
 		newLineVector.push_back(y);
 		if (newLineVector.size() > 1)
-		{
-			if (_alien)
-				_alienRegionLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
-			else
-				_xcomRegionLines.back()->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
-		}
+			totalLine->drawLine(x, y, x+17, newLineVector.at(newLineVector.size()-2), color);
 	}
-	if (_alien)
-		_alienRegionLines.back()->setVisible(_regionToggles.back()->_pushed);
-	else
-		_xcomRegionLines.back()->setVisible(_regionToggles.back()->_pushed);
+	totalLine->setVisible(_regionToggles.back()->_pushed);
 	updateScale(lowerLimit, upperLimit);
 	_txtFactor->setVisible(false);
 }
@@ -1070,13 +1052,14 @@ void GraphsState::drawFinanceLines()
 	for (int button = 0; button != 5; ++button)
 	{
 		_financeLines.at(button)->setVisible(_financeToggles.at(button));
-		_financeLines.at(button)->clear();
 	}
 	range = upperLimit - lowerLimit;
 	//figure out how many units to the pixel, then plot the points for the graph and connect the dots.
 	double units = range / 126;
 	for (int button = 0; button != 5; ++button)
 	{
+		if (!prepareLine(_financeLines.at(button), lowerLimit, upperLimit))
+			continue;
 		std::vector<Sint16> newLineVector;
 		for (int iter = 0; iter != 12; ++iter)
 		{
@@ -17,6 +17,7 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <map>
 #include "../Engine/State.h"
 
 namespace OpenXcom
@@ -53,6 +54,7 @@ private:
 	std::vector<Surface *> _alienRegionLines, _alienCountryLines;
 	std::vector<Surface *> _xcomRegionLines, _xcomCountryLines;
 	std::vector<Surface *> _financeLines, _incomeLines;
+	std::map<Surface *, std::pair<int, int> > _lineScales;
 	bool _alien, _income, _country, _finance;
 	static const size_t GRAPH_MAX_BUTTONS=16;
 	//will be only between 0 and size()
@@ -60,6 +62,8 @@ private:
 	//scroll and repaint buttons functions
 	void scrollButtons(std::vector<GraphButInfo *> &toggles, std::vector<ToggleTextButton *> &buttons, size_t &offset, int step);
 	void updateButton(GraphButInfo *from,ToggleTextButton *to);
+	/// Checks if a line has to be redrawn for a scale.
+	bool prepareLine(Surface *line, int lowerLimit, int upperLimit);
 public:
 	/// Creates the Graphs state.
 	GraphsState();
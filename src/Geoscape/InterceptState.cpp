@@ -140,8 +140,8 @@ InterceptState::InterceptState(Globe *globe, Base *base, Target *target) : _glob
 				ss << 0;
 			}
 			_crafts.push_back(*j);
-			_lstCrafts->addRow(4, (*j)->getName(_game->getLanguage()).c_str(), tr((*j)->getStatus()).c_str(), (*i)->getName().c_str(), ss.str().c_str());
-			if ((*j)->getStatus() == "STR_READY")
+			_lstCrafts->addRow(4, (*j)->getName(_game->getLanguage()).c_str(), tr((*j)->getStatusName()).c_str(), (*i)->getName().c_str(), ss.str().c_str());
+			if ((*j)->getStatus() == CRAFT_READY)
 			{
 				_lstCrafts->setCellColor(row, 1, _lstCrafts->getSecondaryColor());
 			}
@@ -184,7 +184,7 @@ void InterceptState::btnGotoBaseClick(Action *)
 void InterceptState::lstCraftsLeftClick(Action *)
 {
 	Craft* c = _crafts[_lstCrafts->getSelectedRow()];
-	if (c->getStatus() == "STR_READY" || ((c->getStatus() == "STR_OUT" || Options::craftLaunchAlways) && !c->getLowFuel() && !c->getMissionComplete()))
+	if (c->getStatus() == CRAFT_READY || ((c->getStatus() == CRAFT_OUT || Options::craftLaunchAlways) && !c->getLowFuel() && !c->getMissionComplete()))
 	{
 		_game->popState();
 		if (_target == 0)
@@ -205,7 +205,7 @@ void InterceptState::lstCraftsLeftClick(Action *)
 void InterceptState::lstCraftsRightClick(Action *)
 {
 	Craft* c = _crafts[_lstCrafts->getSelectedRow()];
-	if (c->getStatus() == "STR_OUT")
+	if (c->getStatus() == CRAFT_OUT)
 	{
 		_globe->center(c->getLongitude(), c->getLatitude());
 		_game->popState();
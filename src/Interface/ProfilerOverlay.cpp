@@ -0,0 +1,161 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ProfilerOverlay.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include "../Engine/Language.h"
+#include "../Engine/Options.h"
+#include "../Engine/Profiler.h"
+#include "../Engine/Timer.h"
+#include "Text.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+	/**
+	 * Sorts sections with the most expensive first.
+	 */
+	bool slowerSection(const Profiler::Summary &a, const Profiler::Summary &b)
+	{
+		return a.average > b.average;
+	}
+}
+
+/**
+ * Creates a profiler overlay of the specified size.
+ * @param width Width in pixels.
+ * @param height Height in pixels.
+ * @param x X position in pixels.
+ * @param y Y position in pixels.
+ */
+ProfilerOverlay::ProfilerOverlay(int width, int height, int x, int y) : Surface(width, height, x, y), _text(0)
+{
+	_visible = Options::profiler;
+
+	_timer = new Timer(500);
+	_timer->onTimer((SurfaceHandler)&ProfilerOverlay::update);
+	_timer->start();
+}
+
+/**
+ * Deletes profiler overlay content.
+ */
+ProfilerOverlay::~ProfilerOverlay()
+{
+	delete _text;
+	delete _timer;
+}
+
+/**
+ * Sets up the text used to show the timings. The overlay
+ * stays blank until it has fonts to work with.
+ * @param big Pointer to large-size font.
+ * @param small Pointer to small-size font.
+ * @param lang Pointer to current language.
+ */
+void ProfilerOverlay::initText(Font *big, Font *small, Language *lang)
+{
+	if (_text == 0)
+	{
+		_text = new Text(getWidth(), getHeight(), 0, 0);
+		_text->setHighContrast(true);
+		_text->setPalette(getPalette());
+	}
+	_text->initText(big, small, lang);
+}
+
+/**
+ * Replaces a certain amount of colors in the overlay palette.
+ * @param colors Pointer to the set of colors.
+ * @param firstcolor Offset of the first color to replace.
+ * @param ncolors Amount of colors to replace.
+ */
+void ProfilerOverlay::setPalette(SDL_Color *colors, int firstcolor, int ncolors)
+{
+	Surface::setPalette(colors, firstcolor, ncolors);
+	if (_text != 0)
+	{
+		_text->setPalette(colors, firstcolor, ncolors);
+	}
+}
+
+/**
+ * Sets the text color of the overlay.
+ * @param color The color to set.
+ */
+void ProfilerOverlay::setColor(Uint8 color)
+{
+	if (_text != 0)
+	{
+		_text->setColor(color);
+	}
+}
+
+/**
+ * Advances the refresh timer.
+ */
+void ProfilerOverlay::think()
+{
+	_timer->think(0, this);
+}
+
+/**
+ * Lists the average and peak time per frame of
+ * every profiled section, slowest first.
+ */
+void ProfilerOverlay::update()
+{
+	if (_text == 0 || !_visible)
+	{
+		return;
+	}
+	std::vector<Profiler::Summary> summary;
+	Profiler::getSummary(summary);
+	std::stable_sort(summary.begin(), summary.end(), slowerSection);
+
+	std::wostringstream ss;
+	ss << std::fixed << std::setprecision(2);
+	if (Profiler::isTracing())
+	{
+		ss << L"TRACING\n";
+	}
+	for (std::vector<Profiler::Summary>::const_iterator i = summary.begin(); i != summary.end(); ++i)
+	{
+		ss << Language::utf8ToWstr(i->name) << L" " << i->average / 1000.0 << L" / " << i->peak / 1000.0 << L"\n";
+	}
+	_text->setText(ss.str());
+	_redraw = true;
+}
+
+/**
+ * Draws the profiler overlay.
+ */
+void ProfilerOverlay::draw()
+{
+	Surface::draw();
+	if (_text != 0 && _visible)
+	{
+		_text->blit(this);
+	}
+}
+
+}
@@ -294,7 +294,7 @@ void NewBattleState::load(const std::string &filename)
 				}
 
 				// Generate items
-				base->getStorageItems()->getContents()->clear();
+				base->getStorageItems()->clear();
 				const std::vector<std::string> &items = mod->getItemsList();
 				for (std::vector<std::string>::const_iterator i = items.begin(); i != items.end(); ++i)
 				{
@@ -315,12 +315,13 @@ void NewBattleState::load(const std::string &filename)
 				else
 				{
 					_craft = base->getCrafts()->front();
-					for (std::map<std::string, int>::iterator i = _craft->getItems()->getContents()->begin(); i != _craft->getItems()->getContents()->end(); ++i)
+					std::map<std::string, int> craftItems = _craft->getItems()->getContents();
+					for (std::map<std::string, int>::iterator i = craftItems.begin(); i != craftItems.end(); ++i)
 					{
 						RuleItem *rule = _game->getMod()->getItem(i->first);
 						if (!rule)
 						{
-							i->second = 0;
+							_craft->getItems()->removeItem(i->first, i->second);
 						}
 					}
 				}
@@ -388,7 +389,7 @@ void NewBattleState::initSave()
 	base->getSoldiers()->clear();
 	for (std::vector<Craft*>::iterator i = base->getCrafts()->begin(); i != base->getCrafts()->end(); ++i) delete (*i);
 	base->getCrafts()->clear();
-	base->getStorageItems()->getContents()->clear();
+	base->getStorageItems()->clear();
 
 	_craft = new Craft(mod->getCraft(_crafts[_cbxCraft->getSelected()]), base, 1);
 	base->getCrafts()->push_back(_craft);
@@ -31,6 +31,7 @@
 #include "../Engine/Timer.h"
 #include "../Engine/CrossPlatform.h"
 #include "../Interface/FpsCounter.h"
+#include "../Interface/ProfilerOverlay.h"
 #include "../Interface/Cursor.h"
 #include "../Interface/Text.h"
 #include "MainMenuState.h"
@@ -92,6 +93,7 @@ StartState::StartState() : _anim(0)
 	// Hide UI
 	_game->getCursor()->setVisible(false);
 	_game->getFpsCounter()->setVisible(false);
+	_game->getProfilerOverlay()->setVisible(false);
 
 	if (Options::reload)
 	{
@@ -177,6 +179,7 @@ void StartState::think()
 		}
 		_game->getCursor()->setVisible(true);
 		_game->getFpsCounter()->setVisible(Options::fpsCounter);
+		_game->getProfilerOverlay()->setVisible(Options::profiler);
 		break;
 	default:
 		break;
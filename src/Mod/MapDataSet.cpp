@@ -18,11 +18,14 @@
  */
 #include "MapDataSet.h"
 #include "MapData.h"
-#include <fstream>
+#include <algorithm>
+#include <cstring>
 #include <SDL_endian.h>
 #include "../Engine/Exception.h"
+#include "../Engine/WorkerPool.h"
 #include "../Engine/SurfaceSet.h"
 #include "../Engine/FileMap.h"
+#include "../Engine/MappedFile.h"
 
 namespace OpenXcom
 {
@@ -159,14 +162,15 @@ void MapDataSet::loadData()
 
 	// Load Terrain Data from MCD file
 	std::string fname = "TERRAIN/" + _name + ".MCD";
-	std::ifstream mapFile(FileMap::getFilePath(fname).c_str(), std::ios::in | std::ios::binary);
+	MappedFile mapFile(FileMap::getFilePath(fname));
 	if (!mapFile)
 	{
 		throw Exception(fname + " not found");
 	}
 
-	while (mapFile.read((char*)&mcd, sizeof(MCD)))
+	for (size_t offset = 0; offset + sizeof(MCD) <= mapFile.getSize(); offset += sizeof(MCD))
 	{
+		memcpy(&mcd, mapFile.getData() + offset, sizeof(MCD));
 		MapData *to = new MapData(this);
 		_objects.push_back(to);
 
@@ -210,18 +214,84 @@ void MapDataSet::loadData()
 		objNumber++;
 	}
 
+	// Load terrain sprites/surfaces/PCK files into a surfaceset
+	_surfaceSet = new SurfaceSet(32, 40);
+	_surfaceSet->loadPck(FileMap::getFilePath("TERRAIN/" + _name + ".PCK"),
+			     FileMap::getFilePath("TERRAIN/" + _name + ".TAB"));
+}
 
-	if (!mapFile.eof())
+namespace
+{
+	/**
+	 * A dataset loaded on a worker thread.
+	 */
+	struct DataSetJob
 	{
-		throw Exception("Invalid MCD file");
+		MapDataSet *set;
+		std::string error;
+	};
+
+	/**
+	 * Loads the MCD and PCK files of one dataset of a batch.
+	 * Runs on a worker thread, so errors are kept for later
+	 * instead of being thrown.
+	 * @param data Pointer to the list of jobs.
+	 * @param index Index of the dataset to load.
+	 */
+	void loadDataSet(void *data, size_t index)
+	{
+		DataSetJob &job = (*(std::vector<DataSetJob>*)data)[index];
+		try
+		{
+			job.set->loadData();
+		}
+		catch (std::exception &e)
+		{
+			job.error = e.what();
+		}
 	}
+}
 
-	mapFile.close();
+/**
+ * Loads the data of several datasets in parallel, since each
+ * one is a separate set of files. Datasets already loaded are
+ * skipped.
+ * @param sets List of datasets to load.
+ */
+void MapDataSet::loadData(const std::vector<MapDataSet*> &sets)
+{
+	std::vector<DataSetJob> jobs;
+	for (std::vector<MapDataSet*>::const_iterator i = sets.begin(); i != sets.end(); ++i)
+	{
+		bool queued = false;
+		for (std::vector<DataSetJob>::const_iterator j = jobs.begin(); j != jobs.end() && !queued; ++j)
+		{
+			queued = (j->set == *i);
+		}
+		if (!(*i)->isLoaded() && !queued)
+		{
+			DataSetJob job;
+			job.set = *i;
+			jobs.push_back(job);
+		}
+	}
+	WorkerPool::run(loadDataSet, &jobs, jobs.size());
+	for (std::vector<DataSetJob>::const_iterator i = jobs.begin(); i != jobs.end(); ++i)
+	{
+		if (!i->error.empty())
+		{
+			throw Exception(i->error);
+		}
+	}
+}
 
-	// Load terrain sprites/surfaces/PCK files into a surfaceset
-	_surfaceSet = new SurfaceSet(32, 40);
-	_surfaceSet->loadPck(FileMap::getFilePath("TERRAIN/" + _name + ".PCK"),
-			     FileMap::getFilePath("TERRAIN/" + _name + ".TAB"));
+/**
+ * Checks if the MCD and PCK data have been loaded.
+ * @return True if loaded.
+ */
+bool MapDataSet::isLoaded() const
+{
+	return _loaded;
 }
 
 /**
@@ -249,26 +319,20 @@ void MapDataSet::unloadData()
 void MapDataSet::loadLOFTEMPS(const std::string &filename, std::vector<Uint16> *voxelData)
 {
 	// Load file
-	std::ifstream mapFile (filename.c_str(), std::ios::in | std::ios::binary);
+	MappedFile mapFile(filename);
 	if (!mapFile)
 	{
 		throw Exception(filename + " not found");
 	}
 
 	Uint16 value;
-
-	while (mapFile.read((char*)&value, sizeof(value)))
+	size_t count = mapFile.getSize() / sizeof(value);
+	voxelData->reserve(voxelData->size() + count);
+	for (size_t i = 0; i < count; ++i)
 	{
-		value = SDL_SwapLE16(value);
-		voxelData->push_back(value);
+		memcpy(&value, mapFile.getData() + i * sizeof(value), sizeof(value));
+		voxelData->push_back(SDL_SwapLE16(value));
 	}
-
-	if (!mapFile.eof())
-	{
-		throw Exception("Invalid LOFTEMPS");
-	}
-
-	mapFile.close();
 }
 
 /**
@@ -60,6 +60,10 @@ public:
 	SurfaceSet *getSurfaceset() const;
 	/// Loads the objects from an MCD file.
 	void loadData();
+	/// Loads several datasets at once.
+	static void loadData(const std::vector<MapDataSet*> &sets);
+	/// Checks if the dataset is loaded.
+	bool isLoaded() const;
 	///	Unloads to free memory.
 	void unloadData();
 	/// Gets a blank floor tile.
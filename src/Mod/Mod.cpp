@@ -19,10 +19,11 @@
 #include "Mod.h"
 #include <algorithm>
 #include <sstream>
-#include <climits>
+#include <set>
 #include "../Engine/CrossPlatform.h"
 #include "../Engine/FileMap.h"
 #include "../Engine/Palette.h"
+#include "../Engine/ColorMatcher.h"
 #include "../Engine/Font.h"
 #include "../Engine/Surface.h"
 #include "../Engine/SurfaceSet.h"
@@ -39,6 +40,7 @@
 #include "../Engine/ShaderMove.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Logger.h"
+#include "../Engine/WorkerPool.h"
 #include "SoundDefinition.h"
 #include "ExtraSprites.h"
 #include "ExtraSounds.h"
@@ -76,6 +78,7 @@
 #include "../Savegame/Soldier.h"
 #include "../Savegame/Craft.h"
 #include "../Savegame/Transfer.h"
+#include "../Savegame/ItemContainer.h"
 #include "../Ufopaedia/Ufopaedia.h"
 #include "../Savegame/AlienStrategy.h"
 #include "../Savegame/GameTime.h"
@@ -87,6 +90,7 @@
 #include "RuleGlobe.h"
 #include "RuleVideo.h"
 #include "RuleConverter.h"
+#include "RulesetCache.h"
 
 namespace OpenXcom
 {
@@ -698,13 +702,51 @@ void Mod::loadAll(const std::vector< std::pair< std::string, std::vector<std::st
 		}
 	}
 	sortLists();
+	buildResearchGraph();
+	indexItems();
 	loadExtraResources();
 	modResources();
 }
 
+namespace
+{
+	/**
+	 * A ruleset file parsed ahead of being applied to the mod.
+	 */
+	struct RulesetFile
+	{
+		std::string filename;
+		YAML::Node doc;
+		std::string error;
+	};
+
+	/**
+	 * Parses one ruleset file of a batch into its YAML document.
+	 * Runs on a worker thread, so errors are kept for later
+	 * instead of being thrown.
+	 * @param data Pointer to the list of ruleset files.
+	 * @param index Index of the file to parse.
+	 */
+	void parseRulesetFile(void *data, size_t index)
+	{
+		RulesetFile &file = (*(std::vector<RulesetFile>*)data)[index];
+		try
+		{
+			file.doc = YAML::LoadFile(file.filename);
+		}
+		catch (std::exception &e)
+		{
+			file.error = e.what();
+		}
+	}
+}
+
 /**
  * Loads a list of rulesets from YAML files for the mod at the specified index. The first
  * mod loaded should be the master at index 0, then 1, and so on.
+ * All the files are parsed in parallel first (or read back from the
+ * ruleset cache if unchanged), then applied in their original order
+ * so later rulesets still override earlier ones.
  * @param rulesetFiles List of rulesets to load.
  * @param modIdx Mod index number.
  */
@@ -712,17 +754,57 @@ void Mod::loadMod(const std::vector<std::string> &rulesetFiles, size_t modIdx)
 {
 	_modOffset = 1000 * modIdx;
 
-	for (std::vector<std::string>::const_iterator i = rulesetFiles.begin(); i != rulesetFiles.end(); ++i)
+	std::vector<RulesetFile> files(rulesetFiles.size());
+	for (size_t i = 0; i < rulesetFiles.size(); ++i)
+	{
+		files[i].filename = rulesetFiles[i];
+	}
+	RulesetCache cache(rulesetFiles);
+	std::vector<YAML::Node> docs;
+	if (Options::rulesetCache && cache.load(docs))
+	{
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			files[i].doc = docs[i];
+		}
+		Log(LOG_VERBOSE) << "Loaded cached rulesets.";
+	}
+	else
+	{
+		WorkerPool::run(parseRulesetFile, &files, files.size());
+		if (Options::rulesetCache)
+		{
+			bool valid = true;
+			for (std::vector<RulesetFile>::const_iterator i = files.begin(); i != files.end() && valid; ++i)
+			{
+				valid = i->error.empty();
+				docs.push_back(i->doc);
+			}
+			if (valid)
+			{
+				cache.save(docs);
+			}
+		}
+	}
+	docs.clear();
+
+	for (std::vector<RulesetFile>::iterator i = files.begin(); i != files.end(); ++i)
 	{
-		Log(LOG_VERBOSE) << "- " << *i;
+		Log(LOG_VERBOSE) << "- " << i->filename;
+		if (!i->error.empty())
+		{
+			throw Exception(i->filename + ": " + i->error);
+		}
 		try
 		{
-			loadFile(*i);
+			loadFile(i->doc);
 		}
 		catch (YAML::Exception &e)
 		{
-			throw Exception((*i) + ": " + std::string(e.what()));
+			throw Exception(i->filename + ": " + std::string(e.what()));
 		}
+		// release the document as soon as it's applied
+		i->doc = YAML::Node();
 	}
 
 	// these need to be validated, otherwise we're gonna get into some serious trouble down the line.
@@ -789,14 +871,12 @@ void Mod::loadMod(const std::vector<std::string> &rulesetFiles, size_t modIdx)
 }
 
 /**
- * Loads a ruleset's contents from a YAML file.
+ * Loads a ruleset's contents from a parsed YAML file.
  * Rules that match pre-existing rules overwrite them.
- * @param filename YAML filename.
+ * @param doc YAML document.
  */
-void Mod::loadFile(const std::string &filename)
+void Mod::loadFile(const YAML::Node &doc)
 {
-	YAML::Node doc = YAML::LoadFile(filename);
-
 	for (YAML::const_iterator i = doc["countries"].begin(); i != doc["countries"].end(); ++i)
 	{
 		RuleCountry *rule = loadRule(*i, &_countries, &_countriesIndex);
@@ -1555,6 +1635,22 @@ RuleItem *Mod::getItem(const std::string &id, bool error) const
 	return getRule(id, "Item", _items, error);
 }
 
+/**
+ * Returns the rules for the specified item,
+ * by the index it was interned with.
+ * @param index Item index.
+ * @param error Throw an error if not found.
+ * @return Rules for the item, or 0 when the item is not found.
+ */
+RuleItem *Mod::getItemByIndex(int index, bool error) const
+{
+	if (index < (int)_itemsByIndex.size() && _itemsByIndex[index] != 0)
+	{
+		return _itemsByIndex[index];
+	}
+	return getItem(ItemContainer::getItemType(index), error);
+}
+
 /**
  * Returns the list of all items
  * provided by the mod.
@@ -1850,6 +1946,32 @@ const std::vector<std::string> &Mod::getManufactureList() const
 	return _manufactureIndex;
 }
 
+/**
+ * Returns the research projects that list a research as a
+ * dependency or unlock, in research list order.
+ * @param research Research project type.
+ * @return The list of dependent research projects.
+ */
+const std::vector<RuleResearch*> &Mod::getResearchDependents(const std::string &research) const
+{
+	static const std::vector<RuleResearch*> none;
+	std::map<std::string, std::vector<RuleResearch*> >::const_iterator i = _researchDependents.find(research);
+	return i != _researchDependents.end() ? i->second : none;
+}
+
+/**
+ * Returns the manufacture projects that list a research as a
+ * requirement, in manufacture list order.
+ * @param research Research project type.
+ * @return The list of dependent manufacture projects.
+ */
+const std::vector<RuleManufacture*> &Mod::getManufactureDependents(const std::string &research) const
+{
+	static const std::vector<RuleManufacture*> none;
+	std::map<std::string, std::vector<RuleManufacture*> >::const_iterator i = _manufactureDependents.find(research);
+	return i != _manufactureDependents.end() ? i->second : none;
+}
+
 /**
  * Generates and returns a list of facilities for custom bases.
  * The list contains all the facilities that are listed in the 'startingBase'
@@ -2127,6 +2249,56 @@ void Mod::sortLists()
 	std::sort(_ufopaediaIndex.begin(), _ufopaediaIndex.end(), compareRule<ArticleDefinition>(this));
 }
 
+/**
+ * Builds the reverse edges of the research tree, so finishing a
+ * research only has to look at the projects that actually refer to it.
+ * Must be called after the lists are sorted to keep their order.
+ */
+void Mod::buildResearchGraph()
+{
+	_researchDependents.clear();
+	_manufactureDependents.clear();
+	for (std::vector<std::string>::const_iterator i = _researchIndex.begin(); i != _researchIndex.end(); ++i)
+	{
+		RuleResearch *rule = getResearch(*i);
+		std::set<std::string> parents;
+		parents.insert(rule->getDependencies().begin(), rule->getDependencies().end());
+		parents.insert(rule->getUnlocked().begin(), rule->getUnlocked().end());
+		for (std::set<std::string>::const_iterator j = parents.begin(); j != parents.end(); ++j)
+		{
+			_researchDependents[*j].push_back(rule);
+		}
+	}
+	for (std::vector<std::string>::const_iterator i = _manufactureIndex.begin(); i != _manufactureIndex.end(); ++i)
+	{
+		RuleManufacture *rule = getManufacture(*i);
+		std::set<std::string> parents(rule->getRequirements().begin(), rule->getRequirements().end());
+		for (std::set<std::string>::const_iterator j = parents.begin(); j != parents.end(); ++j)
+		{
+			_manufactureDependents[*j].push_back(rule);
+		}
+	}
+}
+
+/**
+ * Interns every item type and keeps the items by their
+ * index, so item containers can look up their rules
+ * without going through the item names.
+ */
+void Mod::indexItems()
+{
+	_itemsByIndex.clear();
+	for (std::map<std::string, RuleItem*>::const_iterator i = _items.begin(); i != _items.end(); ++i)
+	{
+		size_t index = ItemContainer::getItemIndex(i->first);
+		if (index >= _itemsByIndex.size())
+		{
+			_itemsByIndex.resize(index + 1, 0);
+		}
+		_itemsByIndex[index] = i->second;
+	}
+}
+
 /**
  * Gets the research-requirements for Psi-Lab (it's a cache for psiStrengthEval)
  */
@@ -2922,6 +3094,51 @@ void Mod::loadBattlescapeResources()
 	}
 }
 
+namespace
+{
+	/**
+	 * Decodes the images of the extra sprites on worker threads a batch
+	 * at a time, just ahead of them being loaded, so only one batch of
+	 * decoded images is held in memory at once. Images have to be
+	 * loaded in the same order they were added.
+	 */
+	class ImagePreloader
+	{
+		static const size_t BATCH_SIZE = 128;
+		std::vector<std::string> _files;
+		size_t _loaded, _preloaded;
+	public:
+		ImagePreloader() : _loaded(0), _preloaded(0)
+		{
+		}
+
+		/// Drops any images decoded but never loaded, even on errors.
+		~ImagePreloader()
+		{
+			Surface::clearPreloadedImages();
+		}
+
+		/// Adds an image to be preloaded.
+		void add(const std::string &file)
+		{
+			_files.push_back(file);
+		}
+
+		/// Decodes the next batch of images once the current one is used up.
+		void next()
+		{
+			if (_loaded == _preloaded && _preloaded < _files.size())
+			{
+				Surface::clearPreloadedImages();
+				size_t end = std::min(_files.size(), _preloaded + BATCH_SIZE);
+				Surface::preloadImages(std::vector<std::string>(_files.begin() + _preloaded, _files.begin() + end));
+				_preloaded = end;
+			}
+			_loaded++;
+		}
+	};
+}
+
 /**
  * Loads the extra resources defined in rulesets.
  */
@@ -2987,6 +3204,37 @@ void Mod::loadExtraResources()
 #endif
 
 	Log(LOG_INFO) << "Loading extra resources from ruleset...";
+	// decode the images in parallel batches, since there can be thousands
+	ImagePreloader images;
+	for (std::vector< std::pair<std::string, ExtraSprites *> >::const_iterator i = _extraSprites.begin(); i != _extraSprites.end(); ++i)
+	{
+		ExtraSprites *spritePack = i->second;
+		if (spritePack->getSingleImage())
+		{
+			images.add(FileMap::getFilePath((*spritePack->getSprites())[0]));
+			continue;
+		}
+		for (std::map<int, std::string>::iterator j = spritePack->getSprites()->begin(); j != spritePack->getSprites()->end(); ++j)
+		{
+			const std::string &fileName = j->second;
+			if (fileName.substr(fileName.length() - 1, 1) == "/")
+			{
+				const std::set<std::string>& contents = FileMap::getVFolderContents(fileName);
+				for (std::set<std::string>::const_iterator k = contents.begin(); k != contents.end(); ++k)
+				{
+					if (isImageFile((*k).substr((*k).length() - 4, (*k).length())))
+					{
+						images.add(FileMap::getFilePath(fileName + *k));
+					}
+				}
+			}
+			else
+			{
+				images.add(FileMap::getFilePath(fileName));
+			}
+		}
+	}
+
 	for (std::vector< std::pair<std::string, ExtraSprites *> >::const_iterator i = _extraSprites.begin(); i != _extraSprites.end(); ++i)
 	{
 		std::string sheetName = i->first;
@@ -3005,6 +3253,7 @@ void Mod::loadExtraResources()
 				delete _surfaces[sheetName];
 				_surfaces[sheetName] = new Surface(spritePack->getWidth(), spritePack->getHeight());
 			}
+			images.next();
 			_surfaces[sheetName]->loadImage(FileMap::getFilePath((*spritePack->getSprites())[0]));
 		}
 		else
@@ -3047,6 +3296,7 @@ void Mod::loadExtraResources()
 					{
 						if (!isImageFile((*k).substr((*k).length() - 4, (*k).length())))
 							continue;
+						images.next();
 						try
 						{
 							std::string fullPath = FileMap::getFilePath(fileName + *k);
@@ -3077,6 +3327,7 @@ void Mod::loadExtraResources()
 				}
 				else
 				{
+					images.next();
 					if (spritePack->getSubX() == 0 && spritePack->getSubY() == 0)
 					{
 						const std::string& fullPath = FileMap::getFilePath(fileName);
@@ -3415,6 +3666,8 @@ void Mod::createTransparencyLUT(Palette *pal)
 {
 	SDL_Color desiredColor;
 	std::vector<Uint8> lookUpTable;
+	lookUpTable.reserve(_transparencies.size() * 4 * 256);
+	ColorMatcher matcher(pal->getColors(), 256);
 	// start with the color sets
 	for (std::vector<SDL_Color>::const_iterator tint = _transparencies.begin(); tint != _transparencies.end(); ++tint)
 	{
@@ -3432,22 +3685,8 @@ void Mod::createTransparencyLUT(Palette *pal)
 				desiredColor.g = std::min(255, (int)(pal->getColors(currentColor)->g) + (tint->g * opacity));
 				desiredColor.b = std::min(255, (int)(pal->getColors(currentColor)->b) + (tint->b * opacity));
 
-				Uint8 closest = 0;
-				int lowestDifference = INT_MAX;
-				// now compare each color in the palette to find the closest match to our desired one
-				for (int comparator = 0; comparator < 256; ++comparator)
-				{
-					int currentDifference = Sqr(desiredColor.r - pal->getColors(comparator)->r) +
-						Sqr(desiredColor.g - pal->getColors(comparator)->g) +
-						Sqr(desiredColor.b - pal->getColors(comparator)->b);
-
-					if (currentDifference < lowestDifference)
-					{
-						closest = comparator;
-						lowestDifference = currentDifference;
-					}
-				}
-				lookUpTable.push_back(closest);
+				// now find the closest match to our desired one in the palette
+				lookUpTable.push_back(matcher.getNearest(desiredColor.r, desiredColor.g, desiredColor.b));
 			}
 		}
 	}
@@ -106,6 +106,7 @@ private:
 	std::map<std::string, RuleCraft*> _crafts;
 	std::map<std::string, RuleCraftWeapon*> _craftWeapons;
 	std::map<std::string, RuleItem*> _items;
+	std::vector<RuleItem*> _itemsByIndex;
 	std::map<std::string, RuleUfo*> _ufos;
 	std::map<std::string, RuleTerrain*> _terrains;
 	std::map<std::string, MapDataSet*> _mapDataSets;
@@ -149,9 +150,11 @@ private:
 	int _facilityListOrder, _craftListOrder, _itemListOrder, _researchListOrder,  _manufactureListOrder, _ufopaediaListOrder, _invListOrder;
 	size_t _modOffset;
 	std::vector<std::string> _psiRequirements; // it's a cache for psiStrengthEval
+	std::map<std::string, std::vector<RuleResearch*> > _researchDependents;
+	std::map<std::string, std::vector<RuleManufacture*> > _manufactureDependents;
 
-	/// Loads a ruleset from a YAML file.
-	void loadFile(const std::string &filename);
+	/// Loads a ruleset from a parsed YAML file.
+	void loadFile(const YAML::Node &doc);
 	/// Loads a ruleset element.
 	template <typename T>
 	T *loadRule(const YAML::Node &node, std::map<std::string, T*> *map, std::vector<std::string> *index = 0, const std::string &key = "type") const;
@@ -180,6 +183,10 @@ private:
 	void modResources();
 	/// Sorts all our lists according to their weight.
 	void sortLists();
+	/// Builds the reverse research dependency graph.
+	void buildResearchGraph();
+	/// Builds the list of items by interned index.
+	void indexItems();
 public:
 	static int DOOR_OPEN;
 	static int SLIDING_DOOR_OPEN;
@@ -275,6 +282,8 @@ public:
 	const std::vector<std::string> &getCraftWeaponsList() const;
 	/// Gets the ruleset for an item type.
 	RuleItem *getItem(const std::string &id, bool error = false) const;
+	/// Gets the ruleset for an interned item index.
+	RuleItem *getItemByIndex(int index, bool error = false) const;
 	/// Gets the available items.
 	const std::vector<std::string> &getItemsList() const;
 	/// Gets the ruleset for a UFO type.
@@ -331,6 +340,10 @@ public:
 	RuleManufacture *getManufacture (const std::string &id, bool error = false) const;
 	/// Gets the list of all manufacture projects.
 	const std::vector<std::string> &getManufactureList() const;
+	/// Gets the research projects that depend on or are unlocked by a research.
+	const std::vector<RuleResearch*> &getResearchDependents(const std::string &research) const;
+	/// Gets the manufacture projects that require a research.
+	const std::vector<RuleManufacture*> &getManufactureDependents(const std::string &research) const;
 	/// Gets facilities for custom bases.
 	std::vector<RuleBaseFacility*> getCustomBaseFacilities() const;
 	/// Gets a specific UfoTrajectory.
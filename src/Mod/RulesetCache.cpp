@@ -0,0 +1,390 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RulesetCache.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+#include <SDL_types.h>
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Options.h"
+#include "../Engine/Logger.h"
+#include "../Engine/WorkerPool.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+	/// Identifies cache files, bump the version whenever the format changes.
+	const char CacheMagic[4] = { 'O', 'X', 'R', 'C' };
+	const Uint32 CacheVersion = 1;
+
+	/// Node types as stored in the cache.
+	enum CachedNodeType { CACHE_UNDEFINED, CACHE_NULL, CACHE_SCALAR, CACHE_SEQUENCE, CACHE_MAP };
+
+	void writeInt(std::ostream &out, Uint32 value)
+	{
+		out.write((const char*)&value, sizeof(value));
+	}
+
+	void writeString(std::ostream &out, const std::string &value)
+	{
+		writeInt(out, value.size());
+		out.write(value.data(), value.size());
+	}
+
+	/**
+	 * Writes a YAML node and all its children.
+	 * @param out Output stream.
+	 * @param node YAML node.
+	 */
+	void writeNode(std::ostream &out, const YAML::Node &node)
+	{
+		switch (node.Type())
+		{
+		case YAML::NodeType::Null:
+			out.put(CACHE_NULL);
+			writeString(out, node.Tag());
+			break;
+		case YAML::NodeType::Scalar:
+			out.put(CACHE_SCALAR);
+			writeString(out, node.Tag());
+			writeString(out, node.Scalar());
+			break;
+		case YAML::NodeType::Sequence:
+			out.put(CACHE_SEQUENCE);
+			writeString(out, node.Tag());
+			writeInt(out, node.size());
+			for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+			{
+				writeNode(out, *i);
+			}
+			break;
+		case YAML::NodeType::Map:
+			out.put(CACHE_MAP);
+			writeString(out, node.Tag());
+			writeInt(out, node.size());
+			for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+			{
+				writeNode(out, i->first);
+				writeNode(out, i->second);
+			}
+			break;
+		default:
+			out.put(CACHE_UNDEFINED);
+			break;
+		}
+	}
+
+	/**
+	 * Reads values back from a block of cached data,
+	 * flagging an error instead of reading past its end.
+	 */
+	struct CacheReader
+	{
+		const char *pos, *end;
+		bool error;
+
+		CacheReader(const char *begin, const char *end) : pos(begin), end(end), error(false)
+		{
+		}
+
+		bool has(size_t size)
+		{
+			error = error || (size_t)(end - pos) < size;
+			return !error;
+		}
+
+		Uint8 readByte()
+		{
+			return has(1) ? (Uint8)*pos++ : 0;
+		}
+
+		Uint32 readInt()
+		{
+			Uint32 value = 0;
+			if (has(sizeof(value)))
+			{
+				std::copy(pos, pos + sizeof(value), (char*)&value);
+				pos += sizeof(value);
+			}
+			return value;
+		}
+
+		std::string readString()
+		{
+			Uint32 size = readInt();
+			if (!has(size))
+				return "";
+			std::string value(pos, size);
+			pos += size;
+			return value;
+		}
+
+		/**
+		 * Reads back a YAML node and all its children.
+		 * @return YAML node.
+		 */
+		YAML::Node readNode()
+		{
+			YAML::Node node;
+			Uint8 type = readByte();
+			if (error || type == CACHE_UNDEFINED)
+				return node;
+			std::string tag = readString();
+			switch (type)
+			{
+			case CACHE_NULL:
+				node = YAML::Node(YAML::NodeType::Null);
+				break;
+			case CACHE_SCALAR:
+				node = readString();
+				break;
+			case CACHE_SEQUENCE:
+				{
+					node = YAML::Node(YAML::NodeType::Sequence);
+					Uint32 size = readInt();
+					for (Uint32 i = 0; i < size && !error; ++i)
+					{
+						node.push_back(readNode());
+					}
+				}
+				break;
+			case CACHE_MAP:
+				{
+					node = YAML::Node(YAML::NodeType::Map);
+					Uint32 size = readInt();
+					for (Uint32 i = 0; i < size && !error; ++i)
+					{
+						YAML::Node key = readNode();
+						node[key] = readNode();
+					}
+				}
+				break;
+			default:
+				error = true;
+				return node;
+			}
+			node.SetTag(tag);
+			return node;
+		}
+	};
+
+	/**
+	 * A cached document waiting to be turned back into nodes.
+	 */
+	struct CachedDocument
+	{
+		const char *begin, *end;
+		YAML::Node doc;
+		bool error;
+	};
+
+	/**
+	 * Rebuilds one cached document. Runs on a worker thread.
+	 * @param data Pointer to the list of cached documents.
+	 * @param index Index of the document to rebuild.
+	 */
+	void readCachedDocument(void *data, size_t index)
+	{
+		CachedDocument &cached = (*(std::vector<CachedDocument>*)data)[index];
+		CacheReader reader(cached.begin, cached.end);
+		cached.doc = reader.readNode();
+		cached.error = reader.error || reader.pos != reader.end;
+	}
+}
+
+std::set<std::string> RulesetCache::_used;
+
+/**
+ * Sets up a cache for a list of ruleset files. The cache
+ * filename is derived from the list, so every combination
+ * of files gets its own cache.
+ * @param files List of ruleset filenames, in load order.
+ */
+RulesetCache::RulesetCache(const std::vector<std::string> &files) : _files(files), _created(time(0))
+{
+	// FNV-1a
+	Uint32 hash = 2166136261u;
+	for (std::vector<std::string>::const_iterator i = _files.begin(); i != _files.end(); ++i)
+	{
+		for (std::string::const_iterator c = i->begin(); c != i->end(); ++c)
+		{
+			hash = (hash ^ (Uint8)*c) * 16777619u;
+		}
+		hash = (hash ^ '\n') * 16777619u;
+		_dates.push_back(CrossPlatform::getDateModified(*i));
+	}
+	std::ostringstream ss;
+	ss << Options::getUserFolder() << "cache/rules_" << std::hex << std::setfill('0') << std::setw(8) << hash << ".dat";
+	_path = ss.str();
+	_used.insert(_path);
+}
+
+/**
+ *
+ */
+RulesetCache::~RulesetCache()
+{
+}
+
+/**
+ * Loads the pre-parsed ruleset documents from the cache.
+ * Fails if there's no cache or it was built from a
+ * different set of files or older versions of them.
+ * @param docs List to fill with a document per file.
+ * @return True if the cache was loaded.
+ */
+bool RulesetCache::load(std::vector<YAML::Node> &docs) const
+{
+	std::ifstream in(_path.c_str(), std::ios::in | std::ios::binary);
+	if (!in)
+	{
+		return false;
+	}
+	std::vector<char> buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	if (buffer.size() < sizeof(CacheMagic) || !std::equal(CacheMagic, CacheMagic + sizeof(CacheMagic), buffer.begin()))
+	{
+		return false;
+	}
+	CacheReader header(&buffer[0] + sizeof(CacheMagic), &buffer[0] + buffer.size());
+	if (header.readInt() != CacheVersion || header.readInt() != _files.size())
+	{
+		return false;
+	}
+	std::vector<Uint32> sizes;
+	for (size_t i = 0; i < _files.size(); ++i)
+	{
+		Uint32 date = header.readInt();
+		if (header.readString() != _files[i] || date != (Uint32)_dates[i] || header.error)
+		{
+			return false;
+		}
+		sizes.push_back(header.readInt());
+	}
+
+	// the documents are independent, so rebuild them in parallel
+	std::vector<CachedDocument> cached(_files.size());
+	const char *pos = header.pos;
+	for (size_t i = 0; i < _files.size(); ++i)
+	{
+		if (!header.has(sizes[i]))
+		{
+			Log(LOG_WARNING) << "Discarding corrupt ruleset cache: " << _path;
+			return false;
+		}
+		cached[i].begin = pos;
+		cached[i].end = pos + sizes[i];
+		pos += sizes[i];
+		header.pos = pos;
+	}
+	WorkerPool::run(readCachedDocument, &cached, cached.size());
+
+	std::vector<YAML::Node> result;
+	for (std::vector<CachedDocument>::iterator i = cached.begin(); i != cached.end(); ++i)
+	{
+		if (i->error)
+		{
+			Log(LOG_WARNING) << "Discarding corrupt ruleset cache: " << _path;
+			return false;
+		}
+		result.push_back(i->doc);
+	}
+	docs.swap(result);
+	return true;
+}
+
+/**
+ * Saves the parsed ruleset documents to the cache, so
+ * they can be loaded directly next time.
+ * @param docs List of documents, one per file.
+ */
+void RulesetCache::save(const std::vector<YAML::Node> &docs) const
+{
+	// timestamps only have a one second resolution, so don't trust
+	// files that may have changed again in the second they were read
+	for (std::vector<time_t>::const_iterator i = _dates.begin(); i != _dates.end(); ++i)
+	{
+		if (*i >= _created)
+		{
+			return;
+		}
+	}
+	std::string folder = Options::getUserFolder() + "cache/";
+	if (!CrossPlatform::folderExists(folder) && !CrossPlatform::createFolder(folder))
+	{
+		return;
+	}
+	std::ofstream out(_path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!out)
+	{
+		Log(LOG_WARNING) << "Failed to save ruleset cache: " << _path;
+		return;
+	}
+	std::vector<std::string> blobs;
+	for (std::vector<YAML::Node>::const_iterator i = docs.begin(); i != docs.end(); ++i)
+	{
+		std::ostringstream blob;
+		writeNode(blob, *i);
+		blobs.push_back(blob.str());
+	}
+	out.write(CacheMagic, sizeof(CacheMagic));
+	writeInt(out, CacheVersion);
+	writeInt(out, _files.size());
+	for (size_t i = 0; i < _files.size(); ++i)
+	{
+		writeInt(out, (Uint32)_dates[i]);
+		writeString(out, _files[i]);
+		writeInt(out, blobs[i].size());
+	}
+	for (std::vector<std::string>::const_iterator i = blobs.begin(); i != blobs.end(); ++i)
+	{
+		out.write(i->data(), i->size());
+	}
+	if (!out)
+	{
+		out.close();
+		CrossPlatform::deleteFile(_path);
+	}
+}
+
+/**
+ * Deletes any ruleset caches that weren't used this run,
+ * so caches for old mod setups and files don't pile up.
+ */
+void RulesetCache::prune()
+{
+	std::string folder = Options::getUserFolder() + "cache/";
+	if (!CrossPlatform::folderExists(folder))
+	{
+		return;
+	}
+	std::vector<std::string> files = CrossPlatform::getFolderContents(folder, "dat");
+	for (std::vector<std::string>::const_iterator i = files.begin(); i != files.end(); ++i)
+	{
+		if (i->compare(0, 6, "rules_") == 0 && _used.find(folder + *i) == _used.end())
+		{
+			CrossPlatform::deleteFile(folder + *i);
+		}
+	}
+}
+
+}
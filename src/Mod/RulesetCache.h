@@ -0,0 +1,56 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <vector>
+#include <set>
+#include <time.h>
+#include <yaml-cpp/yaml.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Keeps a pre-parsed copy of a mod's ruleset files on disk,
+ * in a compact binary form that's much faster to read back
+ * than parsing the original YAML. The cache is only used if
+ * the exact same files are loaded and none have been modified.
+ */
+class RulesetCache
+{
+private:
+	std::string _path;
+	std::vector<std::string> _files;
+	std::vector<time_t> _dates;
+	time_t _created;
+	static std::set<std::string> _used;
+public:
+	/// Creates a cache for a list of ruleset files.
+	RulesetCache(const std::vector<std::string> &files);
+	/// Cleans up the cache.
+	~RulesetCache();
+	/// Loads the cached documents, if they're up to date.
+	bool load(std::vector<YAML::Node> &docs) const;
+	/// Saves the parsed documents to the cache.
+	void save(const std::vector<YAML::Node> &docs) const;
+	/// Deletes the caches that weren't used this run.
+	static void prune();
+};
+
+}
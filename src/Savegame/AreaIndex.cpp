@@ -0,0 +1,136 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "AreaIndex.h"
+#include <algorithm>
+#include "../fmath.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Initializes an index with no areas.
+ */
+AreaIndex::AreaIndex() : _cells(LON_CELLS * LAT_CELLS), _areas(0)
+{
+}
+
+/**
+ *
+ */
+AreaIndex::~AreaIndex()
+{
+}
+
+/**
+ * Gets the grid column a longitude falls in.
+ * @param lon Longitude in radians.
+ * @return Column, clamped to the grid.
+ */
+int AreaIndex::getLonCell(double lon)
+{
+	int cell = (int)floor(lon / (M_PI * 2.0) * LON_CELLS);
+	return std::max(0, std::min(LON_CELLS - 1, cell));
+}
+
+/**
+ * Gets the grid row a latitude falls in.
+ * @param lat Latitude in radians.
+ * @return Row, clamped to the grid.
+ */
+int AreaIndex::getLatCell(double lat)
+{
+	int cell = (int)floor((lat + M_PI_2) / M_PI * LAT_CELLS);
+	return std::max(0, std::min(LAT_CELLS - 1, cell));
+}
+
+/**
+ * Removes all the areas from the index.
+ */
+void AreaIndex::clear()
+{
+	for (std::vector< std::vector<size_t> >::iterator i = _cells.begin(); i != _cells.end(); ++i)
+	{
+		i->clear();
+	}
+	_areas = 0;
+}
+
+/**
+ * Gets the number of areas in the index.
+ * @return Number of areas.
+ */
+size_t AreaIndex::size() const
+{
+	return _areas;
+}
+
+/**
+ * Adds an area to the index, made up of the same boxes used by
+ * RuleRegion::insideRegion and RuleCountry::insideCountry.
+ * The area is numbered after the ones already added.
+ * @param lonMin Minimum longitude of each box.
+ * @param lonMax Maximum longitude of each box.
+ * @param latMin Minimum latitude of each box.
+ * @param latMax Maximum latitude of each box.
+ */
+void AreaIndex::add(const std::vector<double> &lonMin, const std::vector<double> &lonMax, const std::vector<double> &latMin, const std::vector<double> &latMax)
+{
+	for (size_t i = 0; i < lonMin.size(); ++i)
+	{
+		int x1 = getLonCell(lonMin[i]), x2 = getLonCell(lonMax[i]);
+		int y1 = getLatCell(latMin[i]), y2 = getLatCell(latMax[i]);
+		// boxes with a bigger minimum wrap around the prime meridian
+		int columns = x2 - x1 + 1;
+		if (lonMin[i] > lonMax[i])
+		{
+			columns = std::min(LON_CELLS, columns + LON_CELLS);
+		}
+		for (int y = y1; y <= y2; ++y)
+		{
+			for (int c = 0; c < columns; ++c)
+			{
+				std::vector<size_t> &cell = _cells[y * LON_CELLS + (x1 + c) % LON_CELLS];
+				if (cell.empty() || cell.back() != _areas)
+				{
+					cell.push_back(_areas);
+				}
+			}
+		}
+	}
+	_areas++;
+}
+
+/**
+ * Gets the areas that might contain a point, in the
+ * order they were added. The point still has to be
+ * checked against each one.
+ * @param lon Longitude in radians.
+ * @param lat Latitude in radians.
+ * @return List of areas, or 0 if the point is off the grid.
+ */
+const std::vector<size_t> *AreaIndex::getCandidates(double lon, double lat) const
+{
+	if (!(lon >= 0 && lon < M_PI * 2.0 && lat >= -M_PI_2 && lat < M_PI_2))
+	{
+		return 0;
+	}
+	return &_cells[getLatCell(lat) * LON_CELLS + getLonCell(lon)];
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <cstddef>
+
+namespace OpenXcom
+{
+
+/**
+ * Speeds up finding which area (region or country) contains a
+ * point on the globe. Remembers which areas overlap each cell of
+ * a coarse longitude/latitude grid, so only those have to be checked.
+ */
+class AreaIndex
+{
+private:
+	static const int LON_CELLS = 72, LAT_CELLS = 36;
+	std::vector< std::vector<size_t> > _cells;
+	size_t _areas;
+	/// Gets the grid column of a longitude.
+	static int getLonCell(double lon);
+	/// Gets the grid row of a latitude.
+	static int getLatCell(double lat);
+public:
+	/// Creates an empty index.
+	AreaIndex();
+	/// Cleans up the index.
+	~AreaIndex();
+	/// Removes all the areas.
+	void clear();
+	/// Gets the number of areas.
+	size_t size() const;
+	/// Adds an area made up of boxes.
+	void add(const std::vector<double> &lonMin, const std::vector<double> &lonMax, const std::vector<double> &latMin, const std::vector<double> &latMax);
+	/// Gets the areas that might contain a point.
+	const std::vector<size_t> *getCandidates(double lon, double lat) const;
+};
+
+}
@@ -20,6 +20,7 @@
 #include "../fmath.h"
 #include <stack>
 #include <algorithm>
+#include <assert.h>
 #include "BaseFacility.h"
 #include "../Mod/RuleBaseFacility.h"
 #include "Craft.h"
@@ -52,7 +53,8 @@ namespace OpenXcom
  * Initializes an empty base.
  * @param mod Pointer to mod.
  */
-Base::Base(const Mod *mod) : Target(), _mod(mod), _scientists(0), _engineers(0), _inBattlescape(false), _retaliationTarget(false)
+Base::Base(const Mod *mod) : Target(), _mod(mod), _scientists(0), _engineers(0), _inBattlescape(false), _retaliationTarget(false),
+	_availableQuarters(0), _availableStores(0), _availableLaboratories(0), _availableWorkshops(0), _availableHangars(0), _availablePsiLabs(0), _availableContainment(0)
 {
 	_items = new ItemContainer();
 }
@@ -123,6 +125,7 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 				Log(LOG_ERROR) << "Failed to load facility " << type;
 			}
 		}
+		updateCapacities();
 	}
 
 	for (YAML::const_iterator i = node["crafts"].begin(); i != node["crafts"].end(); ++i)
@@ -170,16 +173,13 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 
 	_items->load(node["items"]);
 	// Some old saves have bad items, better get rid of them to avoid further bugs
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end();)
+	std::map<std::string, int> items = _items->getContents();
+	for (std::map<std::string, int>::iterator i = items.begin(); i != items.end(); ++i)
 	{
 		if (_mod->getItem(i->first) == 0)
 		{
 			Log(LOG_ERROR) << "Failed to load item " << i->first;
-			_items->getContents()->erase(i++);
-		}
-		else
-		{
-			++i;
+			_items->removeItem(i->first, i->second);
 		}
 	}
 
@@ -316,6 +316,41 @@ std::vector<BaseFacility*> *Base::getFacilities()
 	return &_facilities;
 }
 
+/**
+ * Adds up a capacity of all the finished facilities in the base.
+ * @param capacity Facility ruleset getter for the capacity.
+ * @return Total capacity.
+ */
+int Base::calculateCapacity(int (RuleBaseFacility::*capacity)() const) const
+{
+	int total = 0;
+	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
+	{
+		if ((*i)->getBuildTime() == 0)
+		{
+			total += ((*i)->getRules()->*capacity)();
+		}
+	}
+	return total;
+}
+
+/**
+ * Counts up the capacities of the base's facilities again.
+ * The base screens ask for them all the time, so they're kept
+ * around instead. This has to be called after a facility is
+ * added, removed or finished.
+ */
+void Base::updateCapacities()
+{
+	_availableQuarters = calculateCapacity(&RuleBaseFacility::getPersonnel);
+	_availableStores = calculateCapacity(&RuleBaseFacility::getStorage);
+	_availableLaboratories = calculateCapacity(&RuleBaseFacility::getLaboratories);
+	_availableWorkshops = calculateCapacity(&RuleBaseFacility::getWorkshops);
+	_availableHangars = calculateCapacity(&RuleBaseFacility::getCrafts);
+	_availablePsiLabs = calculateCapacity(&RuleBaseFacility::getPsiLaboratories);
+	_availableContainment = calculateCapacity(&RuleBaseFacility::getAliens);
+}
+
 /**
  * Returns the list of soldiers in the base.
  * @return Pointer to the soldier list.
@@ -454,6 +489,25 @@ int Base::insideRadarRange(Target *target) const
 	return insideRange? 1 : 0;
 }
 
+/**
+ * Returns the range of the longest-ranged radar in the
+ * base, so targets further away can be skipped without
+ * checking every facility.
+ * @return Radar range in nautical miles, 0 if there's none.
+ */
+int Base::getRadarRange() const
+{
+	int range = 0;
+	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
+	{
+		if ((*i)->getBuildTime() == 0)
+		{
+			range = std::max(range, (*i)->getRules()->getRadarRange());
+		}
+	}
+	return range;
+}
+
 /**
  * Returns the amount of soldiers contained
  * in the base without any assignments.
@@ -469,7 +523,7 @@ int Base::getAvailableSoldiers(bool checkCombatReadiness) const
 		{
 			total++;
 		}
-		else if (checkCombatReadiness && (((*i)->getCraft() != 0 && (*i)->getCraft()->getStatus() != "STR_OUT") ||
+		else if (checkCombatReadiness && (((*i)->getCraft() != 0 && (*i)->getCraft()->getStatus() != CRAFT_OUT) ||
 			((*i)->getCraft() == 0 && (*i)->getWoundRecovery() == 0)))
 		{
 			total++;
@@ -580,15 +634,8 @@ int Base::getUsedQuarters() const
  */
 int Base::getAvailableQuarters() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getPersonnel();
-		}
-	}
-	return total;
+	assert(_availableQuarters == calculateCapacity(&RuleBaseFacility::getPersonnel) && "Facilities changed without updating capacities.");
+	return _availableQuarters;
 }
 
 /**
@@ -646,15 +693,8 @@ bool Base::storesOverfull(double offset)
  */
 int Base::getAvailableStores() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getStorage();
-		}
-	}
-	return total;
+	assert(_availableStores == calculateCapacity(&RuleBaseFacility::getStorage) && "Facilities changed without updating capacities.");
+	return _availableStores;
 }
 
 /**
@@ -666,7 +706,7 @@ double Base::getIgnoredStores()
 	double space = 0;
 	for (std::vector<Craft*>::iterator c = getCrafts()->begin(); c != getCrafts()->end(); ++c)
 	{
-		if ((*c)->getStatus() == "STR_REARMING")
+		if ((*c)->getStatus() == CRAFT_REARMING)
 		{
 			for (std::vector<CraftWeapon*>::iterator w = (*c)->getWeapons()->begin(); w != (*c)->getWeapons()->end() ; ++w)
 			{
@@ -716,15 +756,8 @@ int Base::getUsedLaboratories() const
  */
 int Base::getAvailableLaboratories() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getLaboratories();
-		}
-	}
-	return total;
+	assert(_availableLaboratories == calculateCapacity(&RuleBaseFacility::getLaboratories) && "Facilities changed without updating capacities.");
+	return _availableLaboratories;
 }
 
 /**
@@ -749,15 +782,8 @@ int Base::getUsedWorkshops() const
  */
 int Base::getAvailableWorkshops() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getWorkshops();
-		}
-	}
-	return total;
+	assert(_availableWorkshops == calculateCapacity(&RuleBaseFacility::getWorkshops) && "Facilities changed without updating capacities.");
+	return _availableWorkshops;
 }
 
 /**
@@ -793,15 +819,8 @@ int Base::getUsedHangars() const
  */
 int Base::getAvailableHangars() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getCrafts();
-		}
-	}
-	return total;
+	assert(_availableHangars == calculateCapacity(&RuleBaseFacility::getCrafts) && "Facilities changed without updating capacities.");
+	return _availableHangars;
 }
 
 /**
@@ -1146,15 +1165,8 @@ bool Base::getHyperDetection() const
  */
 int Base::getAvailablePsiLabs() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getPsiLaboratories();
-		}
-	}
-	return total;
+	assert(_availablePsiLabs == calculateCapacity(&RuleBaseFacility::getPsiLaboratories) && "Facilities changed without updating capacities.");
+	return _availablePsiLabs;
 }
 
 /**
@@ -1183,11 +1195,12 @@ int Base::getUsedPsiLabs() const
 int Base::getUsedContainment() const
 {
 	int total = 0;
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end(); ++i)
+	const std::vector<int> &items = _items->getQuantities();
+	for (size_t i = 0; i < items.size(); ++i)
 	{
-		if (_mod->getItem((i)->first, true)->isAlien())
+		if (items[i] != 0 && _mod->getItemByIndex(i, true)->isAlien())
 		{
-			total += (i)->second;
+			total += items[i];
 		}
 	}
 	for (std::vector<Transfer*>::const_iterator i = _transfers.begin(); i != _transfers.end(); ++i)
@@ -1218,15 +1231,8 @@ int Base::getUsedContainment() const
  */
 int Base::getAvailableContainment() const
 {
-	int total = 0;
-	for (std::vector<BaseFacility*>::const_iterator i = _facilities.begin(); i != _facilities.end(); ++i)
-	{
-		if ((*i)->getBuildTime() == 0)
-		{
-			total += (*i)->getRules()->getAliens();
-		}
-	}
-	return total;
+	assert(_availableContainment == calculateCapacity(&RuleBaseFacility::getAliens) && "Facilities changed without updating capacities.");
+	return _availableContainment;
 }
 
 /**
@@ -1366,7 +1372,7 @@ void Base::setupDefenses()
 	// add vehicles that are in the crafts of the base, if it's not out
 	for (std::vector<Craft*>::iterator c = getCrafts()->begin(); c != getCrafts()->end(); ++c)
 	{
-		if ((*c)->getStatus() != "STR_OUT")
+		if ((*c)->getStatus() != CRAFT_OUT)
 		{
 			for (std::vector<Vehicle*>::iterator i = (*c)->getVehicles()->begin(); i != (*c)->getVehicles()->end(); ++i)
 			{
@@ -1376,7 +1382,8 @@ void Base::setupDefenses()
 	}
 
 	// add vehicles left on the base
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end(); )
+	std::map<std::string, int> items = _items->getContents();
+	for (std::map<std::string, int>::iterator i = items.begin(); i != items.end(); ++i)
 	{
 		std::string itemId = (i)->first;
 		int itemQty = (i)->second;
@@ -1413,7 +1420,6 @@ void Base::setupDefenses()
 				int baseQty = _items->getItem(ammo->getType()) / ammoPerVehicle;
 				if (!baseQty)
 				{
-					++i;
 					continue;
 				}
 				int canBeAdded = std::min(itemQty, baseQty);
@@ -1424,10 +1430,7 @@ void Base::setupDefenses()
 				}
 				_items->removeItem(itemId, canBeAdded);
 			}
-
-			i = _items->getContents()->begin(); // we have to start over because iterator is broken because of the removeItem
 		}
-		else ++i;
 	}
 }
 
@@ -1572,12 +1575,16 @@ void Base::destroyFacility(std::vector<BaseFacility*>::iterator facility)
 				}
 			}
 			// remove all items
-			while (!(*facility)->getCraft()->getItems()->getContents()->empty())
+			ItemContainer *craftItems = (*facility)->getCraft()->getItems();
+			const std::vector<int> &items = craftItems->getQuantities();
+			for (size_t i = 0; i < items.size(); ++i)
 			{
-				std::map<std::string, int>::iterator i = (*facility)->getCraft()->getItems()->getContents()->begin();
-				_items->addItem(i->first, i->second);
-				(*facility)->getCraft()->getItems()->removeItem(i->first, i->second);
+				if (items[i] != 0)
+				{
+					_items->addItem(i, items[i]);
+				}
 			}
+			craftItems->clear();
 			for (std::vector<Craft*>::iterator i = _crafts.begin(); i != _crafts.end(); ++i)
 			{
 				if (*i == (*facility)->getCraft())
@@ -1717,6 +1724,7 @@ void Base::destroyFacility(std::vector<BaseFacility*>::iterator facility)
 	}
 	delete *facility;
 	_facilities.erase(facility);
+	updateCapacities();
 }
 
 /**
@@ -27,6 +27,7 @@ namespace OpenXcom
 
 class Mod;
 class BaseFacility;
+class RuleBaseFacility;
 class Soldier;
 class Craft;
 class ItemContainer;
@@ -59,7 +60,10 @@ private:
 	bool _retaliationTarget;
 	std::vector<Vehicle*> _vehicles;
 	std::vector<BaseFacility*> _defenses;
+	int _availableQuarters, _availableStores, _availableLaboratories, _availableWorkshops, _availableHangars, _availablePsiLabs, _availableContainment;
 
+	/// Adds up a capacity of the finished facilities.
+	int calculateCapacity(int (RuleBaseFacility::*capacity)() const) const;
 	/// Determines space taken up by ammo clips about to rearm craft.
 	double getIgnoredStores();
 	/// Gets the base's default name (unused).
@@ -81,6 +85,8 @@ public:
 	int getMarker() const;
 	/// Gets the base's facilities.
 	std::vector<BaseFacility*> *getFacilities();
+	/// Updates the capacities of the base's facilities.
+	void updateCapacities();
 	/// Gets the base's soldiers.
 	std::vector<Soldier*> *getSoldiers();
 	/// Gets the base's crafts.
@@ -101,6 +107,8 @@ public:
 	int detect(Target *target) const;
 	/// Checks if a target is inside the base's radar range.
 	int insideRadarRange(Target *target) const;
+	/// Gets the range of the base's longest radar.
+	int getRadarRange() const;
 	/// Gets the base's available soldiers.
 	int getAvailableSoldiers(bool checkCombatReadiness = false) const;
 	/// Gets the base's total soldiers.
@@ -132,6 +132,7 @@ int BaseFacility::getBuildTime() const
 void BaseFacility::setBuildTime(int time)
 {
 	_buildTime = time;
+	_base->updateCapacities();
 }
 
 /**
@@ -140,6 +141,10 @@ void BaseFacility::setBuildTime(int time)
 void BaseFacility::build()
 {
 	_buildTime--;
+	if (_buildTime == 0)
+	{
+		_base->updateCapacities();
+	}
 }
 
 /**
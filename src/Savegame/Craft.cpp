@@ -40,6 +40,9 @@
 namespace OpenXcom
 {
 
+/// Names of the craft statuses, in the same order as CraftStatus.
+static const char *const StatusNames[] = { "STR_READY", "STR_REPAIRS", "STR_REFUELLING", "STR_REARMING", "STR_OUT" };
+
 /**
  * Initializes a craft of the specified type and
  * assigns it the latest craft ID available.
@@ -47,7 +50,7 @@ namespace OpenXcom
  * @param base Pointer to base of origin.
  * @param id ID to assign to the craft (0 to not assign).
  */
-Craft::Craft(RuleCraft *rules, Base *base, int id) : MovingTarget(), _rules(rules), _base(base), _id(0), _fuel(0), _damage(0), _interceptionOrder(0), _takeoff(0), _status("STR_READY"), _lowFuel(false), _mission(false), _inBattlescape(false), _inDogfight(false)
+Craft::Craft(RuleCraft *rules, Base *base, int id) : MovingTarget(), _rules(rules), _base(base), _id(0), _fuel(0), _damage(0), _interceptionOrder(0), _takeoff(0), _status(CRAFT_READY), _lowFuel(false), _mission(false), _inBattlescape(false), _inDogfight(false)
 {
 	_items = new ItemContainer();
 	if (id != 0)
@@ -119,16 +122,13 @@ void Craft::load(const YAML::Node &node, const Mod *mod, SavedGame *save)
 
 	_items->load(node["items"]);
 	// Some old saves have bad items, better get rid of them to avoid further bugs
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end();)
+	std::map<std::string, int> items = _items->getContents();
+	for (std::map<std::string, int>::iterator i = items.begin(); i != items.end(); ++i)
 	{
 		if (mod->getItem(i->first) == 0)
 		{
 			Log(LOG_ERROR) << "Failed to load item " << i->first;
-			_items->getContents()->erase(i++);
-		}
-		else
-		{
-			++i;
+			_items->removeItem(i->first, i->second);
 		}
 	}
 	for (YAML::const_iterator i = node["vehicles"].begin(); i != node["vehicles"].end(); ++i)
@@ -145,7 +145,15 @@ void Craft::load(const YAML::Node &node, const Mod *mod, SavedGame *save)
 			Log(LOG_ERROR) << "Failed to load item " << type;
 		}
 	}
-	_status = node["status"].as<std::string>(_status);
+	std::string status = node["status"].as<std::string>(getStatusName());
+	_status = CRAFT_READY;
+	for (int i = 0; i <= CRAFT_OUT; ++i)
+	{
+		if (status == StatusNames[i])
+		{
+			_status = (CraftStatus)i;
+		}
+	}
 	_lowFuel = node["lowFuel"].as<bool>(_lowFuel);
 	_mission = node["mission"].as<bool>(_mission);
 	_interceptionOrder = node["interceptionOrder"].as<int>(_interceptionOrder);
@@ -238,7 +246,7 @@ YAML::Node Craft::save() const
 	{
 		node["vehicles"].push_back((*i)->save());
 	}
-	node["status"] = _status;
+	node["status"] = getStatusName();
 	if (_lowFuel)
 		node["lowFuel"] = _lowFuel;
 	if (_mission)
@@ -325,7 +333,7 @@ std::wstring Craft::getDefaultName(Language *lang) const
  */
 int Craft::getMarker() const
 {
-	if (_status != "STR_OUT")
+	if (_status != CRAFT_OUT)
 		return -1;
 	else if (_rules->getMarker() == -1)
 		return 1;
@@ -358,18 +366,28 @@ void Craft::setBase(Base *base, bool move)
 
 /**
  * Returns the current status of the craft.
- * @return Status string.
+ * @return Status.
  */
-std::string Craft::getStatus() const
+CraftStatus Craft::getStatus() const
 {
 	return _status;
 }
 
+/**
+ * Returns the name of the current status of the
+ * craft, as shown to the player and saved.
+ * @return Status string.
+ */
+std::string Craft::getStatusName() const
+{
+	return StatusNames[_status];
+}
+
 /**
  * Changes the current status of the craft.
- * @param status Status string.
+ * @param status Status.
  */
-void Craft::setStatus(const std::string &status)
+void Craft::setStatus(CraftStatus status)
 {
 	_status = status;
 }
@@ -398,7 +416,7 @@ std::string Craft::getAltitude() const
  */
 void Craft::setDestination(Target *dest)
 {
-	if (_status != "STR_OUT")
+	if (_status != CRAFT_OUT)
 	{
 		_takeoff = 60;
 	}
@@ -691,6 +709,16 @@ void Craft::think()
 	}
 }
 
+/**
+ * Checks if the craft has nowhere to go and isn't
+ * taking off, so thinking won't change anything about it.
+ * @return True if the craft is stationary.
+ */
+bool Craft::isStationary() const
+{
+	return _dest == 0 && _takeoff == 0 && !isDestroyed();
+}
+
 /**
  * Checks the condition of all the craft's systems
  * to define its new status (eg. when arriving at base).
@@ -715,15 +743,15 @@ void Craft::checkup()
 
 	if (_damage > 0)
 	{
-		_status = "STR_REPAIRS";
+		_status = CRAFT_REPAIRS;
 	}
 	else if (available != full)
 	{
-		_status = "STR_REARMING";
+		_status = CRAFT_REARMING;
 	}
 	else
 	{
-		_status = "STR_REFUELLING";
+		_status = CRAFT_REFUELLING;
 	}
 }
 
@@ -777,7 +805,7 @@ void Craft::repair()
 	setDamage(_damage - _rules->getRepairRate());
 	if (_damage <= 0)
 	{
-		_status = "STR_REARMING";
+		_status = CRAFT_REARMING;
 	}
 }
 
@@ -790,12 +818,12 @@ void Craft::refuel()
 	setFuel(_fuel + _rules->getRefuelRate());
 	if (_fuel >= _rules->getMaxFuel())
 	{
-		_status = "STR_READY";
+		_status = CRAFT_READY;
 		for (std::vector<CraftWeapon*>::iterator i = _weapons.begin(); i != _weapons.end(); ++i)
 		{
 			if (*i && (*i)->isRearming())
 			{
-				_status = "STR_REARMING";
+				_status = CRAFT_REARMING;
 				break;
 			}
 		}
@@ -815,7 +843,7 @@ std::string Craft::rearm(const Mod *mod)
 	{
 		if (i == _weapons.end())
 		{
-			_status = "STR_REFUELLING";
+			_status = CRAFT_REFUELLING;
 			break;
 		}
 		if (*i != 0 && (*i)->isRearming())
@@ -987,9 +1015,13 @@ void Craft::unload(const Mod *mod)
 	}
 
 	// Remove items
-	for (std::map<std::string, int>::iterator it = _items->getContents()->begin(); it != _items->getContents()->end(); ++it)
+	const std::vector<int> &items = _items->getQuantities();
+	for (size_t i = 0; i < items.size(); ++i)
 	{
-		_base->getStorageItems()->addItem(it->first, it->second);
+		if (items[i] != 0)
+		{
+			_base->getStorageItems()->addItem(i, items[i]);
+		}
 	}
 
 	// Remove vehicles
@@ -1019,7 +1051,7 @@ void Craft::unload(const Mod *mod)
  */
 void Craft::reuseItem(const std::string& item)
 {
-	if (_status != "STR_READY")
+	if (_status != CRAFT_READY)
 		return;
 	// Check if it's ammo to reload the craft
 	for (std::vector<CraftWeapon*>::iterator w = _weapons.begin(); w != _weapons.end(); ++w)
@@ -1027,12 +1059,12 @@ void Craft::reuseItem(const std::string& item)
 		if ((*w) != 0 && item == (*w)->getRules()->getClipItem() && (*w)->getAmmo() < (*w)->getRules()->getAmmoMax())
 		{
 			(*w)->setRearming(true);
-			_status = "STR_REARMING";
+			_status = CRAFT_REARMING;
 		}
 	}
 	// Check if it's fuel to refuel the craft
 	if (item == _rules->getRefuelItem() && _fuel < _rules->getMaxFuel())
-		_status = "STR_REFUELLING";
+		_status = CRAFT_REFUELLING;
 }
 
 }
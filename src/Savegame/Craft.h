@@ -27,6 +27,9 @@ namespace OpenXcom
 
 typedef std::pair<std::string, int> CraftId;
 
+/// Statuses a craft can be in, saved by name.
+enum CraftStatus { CRAFT_READY, CRAFT_REPAIRS, CRAFT_REFUELLING, CRAFT_REARMING, CRAFT_OUT };
+
 class RuleCraft;
 class Base;
 class Soldier;
@@ -51,7 +54,7 @@ private:
 	std::vector<CraftWeapon*> _weapons;
 	ItemContainer *_items;
 	std::vector<Vehicle*> _vehicles;
-	std::string _status;
+	CraftStatus _status;
 	bool _lowFuel, _mission, _inBattlescape, _inDogfight;
 public:
 	/// Creates a craft of the specified type.
@@ -81,9 +84,11 @@ public:
 	/// Sets the craft's base.
 	void setBase(Base *base, bool move = true);
 	/// Gets the craft's status.
-	std::string getStatus() const;
+	CraftStatus getStatus() const;
+	/// Gets the name of the craft's status.
+	std::string getStatusName() const;
 	/// Sets the craft's status.
-	void setStatus(const std::string &status);
+	void setStatus(CraftStatus status);
 	/// Gets the craft's altitude.
 	std::string getAltitude() const;
 	/// Sets the craft's destination.
@@ -138,6 +143,8 @@ public:
 	bool insideRadarRange(Target *target) const;
 	/// Handles craft logic.
 	void think();
+	/// Checks if the craft will stay put while thinking.
+	bool isStationary() const;
 	/// Does a craft full checkup.
 	void checkup();
 	/// Consumes the craft's fuel.
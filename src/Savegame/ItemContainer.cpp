@@ -17,16 +17,51 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "ItemContainer.h"
+#include <assert.h>
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
 
 namespace OpenXcom
 {
 
+std::map<std::string, int> ItemContainer::_indices;
+std::vector<std::string> ItemContainer::_types;
+
+/**
+ * Returns the interned index of an item type, giving it
+ * a new one the first time it's seen. Indices are shared by
+ * all containers and never change once given out, so the mod
+ * hands them out to all its items when it's loaded.
+ * @param type Item type.
+ * @return Item index.
+ */
+int ItemContainer::getItemIndex(const std::string &type)
+{
+	std::map<std::string, int>::const_iterator i = _indices.find(type);
+	if (i != _indices.end())
+	{
+		return i->second;
+	}
+	int index = _types.size();
+	_indices[type] = index;
+	_types.push_back(type);
+	return index;
+}
+
+/**
+ * Returns the item type of an interned index.
+ * @param index Item index.
+ * @return Item type.
+ */
+const std::string &ItemContainer::getItemType(int index)
+{
+	return _types.at(index);
+}
+
 /**
  * Initializes an item container with no contents.
  */
-ItemContainer::ItemContainer()
+ItemContainer::ItemContainer() : _totalSize(0), _totalSizeMod(0)
 {
 }
 
@@ -43,7 +78,12 @@ ItemContainer::~ItemContainer()
  */
 void ItemContainer::load(const YAML::Node &node)
 {
-	_qty = node.as< std::map<std::string, int> >(_qty);
+	std::map<std::string, int> qty = node.as< std::map<std::string, int> >(getContents());
+	clear();
+	for (std::map<std::string, int>::const_iterator i = qty.begin(); i != qty.end(); ++i)
+	{
+		addItem(i->first, i->second);
+	}
 }
 
 /**
@@ -53,7 +93,7 @@ void ItemContainer::load(const YAML::Node &node)
 YAML::Node ItemContainer::save() const
 {
 	YAML::Node node;
-	node = _qty;
+	node = getContents();
 	return node;
 }
 
@@ -68,11 +108,22 @@ void ItemContainer::addItem(const std::string &id, int qty)
 	{
 		return;
 	}
-	if (_qty.find(id) == _qty.end())
+	addItem(getItemIndex(id), qty);
+}
+
+/**
+ * Adds an item amount to the container.
+ * @param index Item index.
+ * @param qty Item quantity.
+ */
+void ItemContainer::addItem(int index, int qty)
+{
+	if (index >= (int)_qty.size())
 	{
-		_qty[id] = 0;
+		_qty.resize(index + 1, 0);
 	}
-	_qty[id] += qty;
+	_qty[index] += qty;
+	_totalSizeMod = 0;
 }
 
 /**
@@ -82,18 +133,37 @@ void ItemContainer::addItem(const std::string &id, int qty)
  */
 void ItemContainer::removeItem(const std::string &id, int qty)
 {
-	if (id.empty() || _qty.find(id) == _qty.end())
+	if (id.empty())
 	{
 		return;
 	}
-	if (qty < _qty[id])
+	std::map<std::string, int>::const_iterator i = _indices.find(id);
+	if (i != _indices.end())
 	{
-		_qty[id] -= qty;
+		removeItem(i->second, qty);
+	}
+}
+
+/**
+ * Removes an item amount from the container.
+ * @param index Item index.
+ * @param qty Item quantity.
+ */
+void ItemContainer::removeItem(int index, int qty)
+{
+	if (index >= (int)_qty.size() || _qty[index] == 0)
+	{
+		return;
+	}
+	if (qty < _qty[index])
+	{
+		_qty[index] -= qty;
 	}
 	else
 	{
-		_qty.erase(id);
+		_qty[index] = 0;
 	}
+	_totalSizeMod = 0;
 }
 
 /**
@@ -108,17 +178,56 @@ int ItemContainer::getItem(const std::string &id) const
 		return 0;
 	}
 
-	std::map<std::string, int>::const_iterator it = _qty.find(id);
-	if (it == _qty.end())
+	std::map<std::string, int>::const_iterator it = _indices.find(id);
+	if (it == _indices.end())
 	{
 		return 0;
 	}
 	else
 	{
-		return it->second;
+		return getItem(it->second);
 	}
 }
 
+/**
+ * Returns the quantity of an item in the container.
+ * @param index Item index.
+ * @return Item quantity.
+ */
+int ItemContainer::getItem(int index) const
+{
+	if (index >= (int)_qty.size())
+	{
+		return 0;
+	}
+	return _qty[index];
+}
+
+/**
+ * Removes all the items from the container.
+ */
+void ItemContainer::clear()
+{
+	_qty.clear();
+	_totalSizeMod = 0;
+}
+
+/**
+ * Checks if there are no items in the container.
+ * @return True if it's empty.
+ */
+bool ItemContainer::empty() const
+{
+	for (std::vector<int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
+	{
+		if (*i != 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
 /**
  * Returns the total quantity of the items in the container.
  * @return Total item quantity.
@@ -126,35 +235,76 @@ int ItemContainer::getItem(const std::string &id) const
 int ItemContainer::getTotalQuantity() const
 {
 	int total = 0;
-	for (std::map<std::string, int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
+	for (std::vector<int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
 	{
-		total += i->second;
+		total += *i;
 	}
 	return total;
 }
 
 /**
- * Returns the total size of the items in the container.
+ * Adds up the size of all the items in the container.
  * @param mod Pointer to mod.
  * @return Total item size.
  */
-double ItemContainer::getTotalSize(const Mod *mod) const
+double ItemContainer::calculateTotalSize(const Mod *mod) const
 {
 	double total = 0;
-	for (std::map<std::string, int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
+	for (size_t i = 0; i < _qty.size(); ++i)
 	{
-		total += mod->getItem(i->first, true)->getSize() * i->second;
+		if (_qty[i] != 0)
+		{
+			total += mod->getItemByIndex(i, true)->getSize() * _qty[i];
+		}
 	}
 	return total;
 }
 
 /**
- * Returns all the items currently contained within.
+ * Returns the total size of the items in the container.
+ * This is asked for all the time by the base screens, so it's
+ * only added up again after the contents change.
+ * @param mod Pointer to mod.
+ * @return Total item size.
+ */
+double ItemContainer::getTotalSize(const Mod *mod) const
+{
+	if (_totalSizeMod != mod)
+	{
+		_totalSize = calculateTotalSize(mod);
+		_totalSizeMod = mod;
+	}
+	assert(_totalSize == calculateTotalSize(mod) && "Item container changed behind its back.");
+	return _totalSize;
+}
+
+/**
+ * Returns the quantity of every item in the container,
+ * indexed by the interned item index. Items past the
+ * end of the list aren't in the container.
+ * @return List of quantities.
+ */
+const std::vector<int> &ItemContainer::getQuantities() const
+{
+	return _qty;
+}
+
+/**
+ * Returns all the items currently contained within,
+ * sorted by item ID.
  * @return List of contents.
  */
-std::map<std::string, int> *ItemContainer::getContents()
+std::map<std::string, int> ItemContainer::getContents() const
 {
-	return &_qty;
+	std::map<std::string, int> contents;
+	for (size_t i = 0; i < _qty.size(); ++i)
+	{
+		if (_qty[i] != 0)
+		{
+			contents[_types[i]] = _qty[i];
+		}
+	}
+	return contents;
 }
 
 }
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string>
+#include <vector>
 #include <map>
 #include <yaml-cpp/yaml.h>
 
@@ -30,12 +31,25 @@ class Mod;
  * Represents the items contained by a certain entity,
  * like base stores, craft equipment, etc.
  * Handles all necessary item management tasks.
+ * Quantities are kept in a plain array indexed by the
+ * interned item index, item names are only used for
+ * YAML I/O and by the string-based accessors.
  */
 class ItemContainer
 {
 private:
-	std::map<std::string, int> _qty;
+	static std::map<std::string, int> _indices;
+	static std::vector<std::string> _types;
+	std::vector<int> _qty;
+	mutable double _totalSize;
+	mutable const Mod *_totalSizeMod;
+	/// Adds up the size of all the items.
+	double calculateTotalSize(const Mod *mod) const;
 public:
+	/// Gets the interned index of an item type.
+	static int getItemIndex(const std::string &type);
+	/// Gets the item type of an interned index.
+	static const std::string &getItemType(int index);
 	/// Creates an empty item container.
 	ItemContainer();
 	/// Cleans up the item container.
@@ -46,16 +60,28 @@ public:
 	YAML::Node save() const;
 	/// Adds an item to the container.
 	void addItem(const std::string &id, int qty = 1);
+	/// Adds an item to the container by index.
+	void addItem(int index, int qty = 1);
 	/// Removes an item from the container.
 	void removeItem(const std::string &id, int qty = 1);
+	/// Removes an item from the container by index.
+	void removeItem(int index, int qty = 1);
 	/// Gets an item in the container.
 	int getItem(const std::string &id) const;
+	/// Gets an item in the container by index.
+	int getItem(int index) const;
+	/// Empties the container.
+	void clear();
+	/// Checks if the container is empty.
+	bool empty() const;
 	/// Gets the total quantity of items in the container.
 	int getTotalQuantity() const;
 	/// Gets the total size of items in the container.
 	double getTotalSize(const Mod *mod) const;
+	/// Gets the quantities of the items in the container by index.
+	const std::vector<int> &getQuantities() const;
 	/// Gets all the items in the container.
-	std::map<std::string, int> *getContents();
+	std::map<std::string, int> getContents() const;
 };
 
 }
@@ -721,6 +721,7 @@ void SaveConverter::loadDatBase()
 					facility->setY(y);
 					facility->setBuildTime(days);
 					base->getFacilities()->push_back(facility);
+					base->updateCapacities();
 				}
 			}
 			int engineers = load<Uint8>(bdata + _rules->getOffset("BASE.DAT_ENGINEERS"));
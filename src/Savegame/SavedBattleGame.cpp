@@ -17,6 +17,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <assert.h>
+#include <algorithm>
+#include <cstdlib>
 #include <vector>
 #include "BattleItem.h"
 #include "SavedBattleGame.h"
@@ -46,7 +48,7 @@ namespace OpenXcom
 /**
  * Initializes a brand new battlescape saved game.
  */
-SavedBattleGame::SavedBattleGame() : _battleState(0), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _selectedUnit(0), _lastSelectedUnit(0), _pathfinding(0), _tileEngine(0), _globalShade(0),
+SavedBattleGame::SavedBattleGame() : _battleState(0), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _selectedUnit(0), _lastSelectedUnit(0), _nodeIndexSize(0), _pathfinding(0), _tileEngine(0), _globalShade(0),
 	_side(FACTION_PLAYER), _turn(1), _debugMode(false), _aborted(false), _itemId(0), _objectiveType(-1), _objectivesDestroyed(0), _objectivesNeeded(0), _unitsFalling(false), _cheating(false),
 	_tuReserved(BA_NONE), _kneelReserved(false), _depth(0), _ambience(-1), _ambientVolume(0.5), _turnLimit(0), _cheatTurn(20), _chronoTrigger(FORCE_LOSE), _beforeGame(true)
 {
@@ -345,9 +347,9 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
  */
 void SavedBattleGame::loadMapResources(Mod *mod)
 {
+	MapDataSet::loadData(_mapDataSets);
 	for (std::vector<MapDataSet*>::const_iterator i = _mapDataSets.begin(); i != _mapDataSets.end(); ++i)
 	{
-		(*i)->loadData();
 		if (mod->getMCDPatch((*i)->getName()))
 		{
 			mod->getMCDPatch((*i)->getName())->modifyData(*i);
@@ -763,6 +765,65 @@ std::vector<Node*> *SavedBattleGame::getNodes()
 	return &_nodes;
 }
 
+/**
+ * Gets the nodes (except dummies) that lie in a square around
+ * a position, on any level, in the same order as the list of nodes.
+ * Nodes are bucketed by map block the first time round,
+ * so this doesn't have to go through every node on the map.
+ * @param pos Center of the square.
+ * @param radius Half the size of the square, in tiles.
+ * @param nodes List to fill with the nodes.
+ */
+void SavedBattleGame::getNodesNear(const Position &pos, int radius, std::vector<Node*> &nodes)
+{
+	const int segmentsX = (_mapsize_x + 9) / 10, segmentsY = (_mapsize_y + 9) / 10;
+	nodes.clear();
+	if (segmentsX <= 0 || segmentsY <= 0)
+	{
+		return;
+	}
+	// nodes are only ever added while the map is generated or loaded
+	if (_nodeIndex.empty() || _nodeIndexSize != _nodes.size())
+	{
+		_nodeIndex.assign(segmentsX * segmentsY, std::vector<size_t>());
+		for (size_t i = 0; i < _nodes.size(); ++i)
+		{
+			if (_nodes[i]->isDummy())
+			{
+				continue;
+			}
+			int x = std::max(0, std::min(segmentsX - 1, _nodes[i]->getPosition().x / 10));
+			int y = std::max(0, std::min(segmentsY - 1, _nodes[i]->getPosition().y / 10));
+			_nodeIndex[y * segmentsX + x].push_back(i);
+		}
+		_nodeIndexSize = _nodes.size();
+	}
+
+	int x1 = std::max(0, (pos.x - radius) / 10), x2 = std::min(segmentsX - 1, (pos.x + radius) / 10);
+	int y1 = std::max(0, (pos.y - radius) / 10), y2 = std::min(segmentsY - 1, (pos.y + radius) / 10);
+	std::vector<size_t> found;
+	for (int y = y1; y <= y2; ++y)
+	{
+		for (int x = x1; x <= x2; ++x)
+		{
+			const std::vector<size_t> &segment = _nodeIndex[y * segmentsX + x];
+			for (std::vector<size_t>::const_iterator i = segment.begin(); i != segment.end(); ++i)
+			{
+				Position nodePos = _nodes[*i]->getPosition();
+				if (std::abs(nodePos.x - pos.x) <= radius && std::abs(nodePos.y - pos.y) <= radius)
+				{
+					found.push_back(*i);
+				}
+			}
+		}
+	}
+	std::sort(found.begin(), found.end());
+	for (std::vector<size_t>::const_iterator i = found.begin(); i != found.end(); ++i)
+	{
+		nodes.push_back(_nodes[*i]);
+	}
+}
+
 /**
  * Gets the list of units.
  * @return Pointer to the list of units.
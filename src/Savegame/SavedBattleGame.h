@@ -52,6 +52,8 @@ private:
 	Tile **_tiles;
 	BattleUnit *_selectedUnit, *_lastSelectedUnit;
 	std::vector<Node*> _nodes;
+	std::vector<std::vector<size_t> > _nodeIndex;
+	size_t _nodeIndexSize;
 	std::vector<BattleUnit*> _units;
 	std::vector<BattleItem*> _items, _deleted;
 	Pathfinding *_pathfinding;
@@ -107,6 +109,8 @@ public:
 	Tile **getTiles() const;
 	/// Gets a pointer to the list of nodes.
 	std::vector<Node*> *getNodes();
+	/// Gets the nodes in a square around a position.
+	void getNodesNear(const Position &pos, int radius, std::vector<Node*> &nodes);
 	/// Gets a pointer to the list of items.
 	std::vector<BattleItem*> *getItems();
 	/// Gets a pointer to the list of units.
@@ -51,6 +51,7 @@
 #include "AlienStrategy.h"
 #include "AlienMission.h"
 #include "../Mod/RuleRegion.h"
+#include "../Mod/RuleCountry.h"
 #include "MissionStatistics.h"
 #include "SoldierDeath.h"
 
@@ -481,9 +482,12 @@ void SavedGame::load(const std::string &filename, Mod *mod)
 	for (YAML::const_iterator it = doc["discovered"].begin(); it != doc["discovered"].end(); ++it)
 	{
 		std::string research = it->as<std::string>();
-		if (mod->getResearch(research))
+		const RuleResearch *rule = mod->getResearch(research);
+		if (rule)
 		{
-			_discovered.push_back(mod->getResearch(research));
+			_discovered.push_back(rule);
+			_discoveredSet.insert(rule);
+			_discoveredNames.insert(rule->getName());
 		}
 		else
 		{
@@ -1079,10 +1083,11 @@ void SavedGame::setBattleGame(SavedBattleGame *battleGame)
  */
 void SavedGame::addFinishedResearch (const RuleResearch * r, const Mod * mod, bool score)
 {
-	std::vector<const RuleResearch *>::const_iterator itDiscovered = std::find(_discovered.begin(), _discovered.end(), r);
-	if (itDiscovered == _discovered.end())
+	if (!isDiscovered(r))
 	{
 		_discovered.push_back(r);
+		_discoveredSet.insert(r);
+		_discoveredNames.insert(r->getName());
 		removePoppedResearch(r);
 		if (score)
 		{
@@ -1092,9 +1097,11 @@ void SavedGame::addFinishedResearch (const RuleResearch * r, const Mod * mod, bo
 	if (mod)
 	{
 		std::vector<RuleResearch*> availableResearch;
+		std::set<const RuleResearch*> unlocked;
+		getUnlockedResearch(unlocked, mod);
 		for (std::vector<Base*>::const_iterator it = _bases.begin(); it != _bases.end(); ++it)
 		{
-			getDependableResearchBasic(availableResearch, r, mod, *it);
+			getDependableResearchBasic(availableResearch, r, mod, *it, unlocked);
 		}
 		for (std::vector<RuleResearch*>::iterator it = availableResearch.begin(); it != availableResearch.end(); ++it)
 		{
@@ -1128,105 +1135,124 @@ const std::vector<const RuleResearch *> & SavedGame::getDiscoveredResearch() con
 }
 
 /**
- * Get the list of RuleResearch which can be researched in a Base.
- * @param projects the list of ResearchProject which are available.
+ * Checks whether a research has been discovered.
+ * @param research Pointer to the research rules.
+ * @return True if it's in the list of discovered research.
+ */
+bool SavedGame::isDiscovered(const RuleResearch *research) const
+{
+	return _discoveredSet.find(research) != _discoveredSet.end();
+}
+
+/**
+ * Gets the set of research projects unlocked by the research
+ * discovered so far.
+ * @param unlocked Set to fill with the unlocked RuleResearch.
  * @param mod the game Mod
- * @param base a pointer to a Base
  */
-void SavedGame::getAvailableResearchProjects (std::vector<RuleResearch *> & projects, const Mod * mod, Base * base) const
+void SavedGame::getUnlockedResearch(std::set<const RuleResearch *> & unlocked, const Mod * mod) const
 {
-	const std::vector<const RuleResearch *> & discovered(getDiscoveredResearch());
-	std::vector<std::string> researchProjects = mod->getResearchList();
-	const std::vector<ResearchProject *> & baseResearchProjects = base->getResearch();
-	std::vector<const RuleResearch *> unlocked;
-	for (std::vector<const RuleResearch *>::const_iterator it = discovered.begin(); it != discovered.end(); ++it)
+	for (std::vector<const RuleResearch *>::const_iterator it = _discovered.begin(); it != _discovered.end(); ++it)
 	{
 		for (std::vector<std::string>::const_iterator itUnlocked = (*it)->getUnlocked().begin(); itUnlocked != (*it)->getUnlocked().end(); ++itUnlocked)
 		{
-			unlocked.push_back(mod->getResearch(*itUnlocked, true));
+			unlocked.insert(mod->getResearch(*itUnlocked, true));
 		}
 	}
+}
+
+/**
+ * Get the list of RuleResearch which can be researched in a Base.
+ * @param projects the list of ResearchProject which are available.
+ * @param mod the game Mod
+ * @param base a pointer to a Base
+ */
+void SavedGame::getAvailableResearchProjects (std::vector<RuleResearch *> & projects, const Mod * mod, Base * base) const
+{
+	const std::vector<std::string> &researchProjects = mod->getResearchList();
+	std::set<const RuleResearch *> unlocked;
+	getUnlockedResearch(unlocked, mod);
 	for (std::vector<std::string>::const_iterator iter = researchProjects.begin(); iter != researchProjects.end(); ++iter)
 	{
 		RuleResearch *research = mod->getResearch(*iter);
-		if (!isResearchAvailable(research, unlocked, mod))
+		if (isResearchProjectAvailable(research, unlocked, mod, base))
 		{
-			continue;
+			projects.push_back (research);
 		}
-		std::vector<const RuleResearch *>::const_iterator itDiscovered = std::find(discovered.begin(), discovered.end(), research);
+	}
+}
 
-		bool liveAlien = mod->getUnit(research->getName()) != 0;
+/**
+ * Checks whether a research project can be started in a Base.
+ * @param research the RuleResearch to test.
+ * @param unlocked the set of currently unlocked RuleResearch
+ * @param mod the game Mod
+ * @param base a pointer to a Base
+ * @return true if the project is available in the Base.
+ */
+bool SavedGame::isResearchProjectAvailable (RuleResearch * research, const std::set<const RuleResearch *> & unlocked, const Mod * mod, Base * base) const
+{
+	if (!isResearchAvailable(research, unlocked, mod))
+	{
+		return false;
+	}
+
+	bool liveAlien = mod->getUnit(research->getName()) != 0;
 
-		if (itDiscovered != discovered.end())
+	if (isDiscovered(research))
+	{
+		bool cull = true;
+		if (!research->getGetOneFree().empty())
 		{
-			bool cull = true;
-			if (!research->getGetOneFree().empty())
+			for (std::vector<std::string>::const_iterator ohBoy = research->getGetOneFree().begin(); ohBoy != research->getGetOneFree().end(); ++ohBoy)
 			{
-				for (std::vector<std::string>::const_iterator ohBoy = research->getGetOneFree().begin(); ohBoy != research->getGetOneFree().end(); ++ohBoy)
+				if (!isDiscovered(mod->getResearch(*ohBoy)))
 				{
-					std::vector<const RuleResearch *>::const_iterator more_iteration = std::find(discovered.begin(), discovered.end(), mod->getResearch(*ohBoy));
-					if (more_iteration == discovered.end())
-					{
-						cull = false;
-						break;
-					}
+					cull = false;
+					break;
 				}
 			}
-			if (!liveAlien && cull)
-			{
-				continue;
-			}
-			else
-			{
-				std::vector<std::string>::const_iterator leaderCheck = std::find(research->getUnlocked().begin(), research->getUnlocked().end(), "STR_LEADER_PLUS");
-				std::vector<std::string>::const_iterator cmnderCheck = std::find(research->getUnlocked().begin(), research->getUnlocked().end(), "STR_COMMANDER_PLUS");
+		}
+		if (!liveAlien && cull)
+		{
+			return false;
+		}
+		else
+		{
+			std::vector<std::string>::const_iterator leaderCheck = std::find(research->getUnlocked().begin(), research->getUnlocked().end(), "STR_LEADER_PLUS");
+			std::vector<std::string>::const_iterator cmnderCheck = std::find(research->getUnlocked().begin(), research->getUnlocked().end(), "STR_COMMANDER_PLUS");
 
-				bool leader ( leaderCheck != research->getUnlocked().end());
-				bool cmnder ( cmnderCheck != research->getUnlocked().end());
+			bool leader ( leaderCheck != research->getUnlocked().end());
+			bool cmnder ( cmnderCheck != research->getUnlocked().end());
 
-				if (leader)
-				{
-					std::vector<const RuleResearch*>::const_iterator found = std::find(discovered.begin(), discovered.end(), mod->getResearch("STR_LEADER_PLUS"));
-					if (found == discovered.end())
-						cull = false;
-				}
+			if (leader && !isDiscovered(mod->getResearch("STR_LEADER_PLUS")))
+				cull = false;
 
-				if (cmnder)
-				{
-					std::vector<const RuleResearch*>::const_iterator found = std::find(discovered.begin(), discovered.end(), mod->getResearch("STR_COMMANDER_PLUS"));
-					if (found == discovered.end())
-						cull = false;
-				}
+			if (cmnder && !isDiscovered(mod->getResearch("STR_COMMANDER_PLUS")))
+				cull = false;
 
-				if (cull)
-					continue;
-			}
+			if (cull)
+				return false;
 		}
+	}
 
-		if (std::find_if (baseResearchProjects.begin(), baseResearchProjects.end(), findRuleResearch(research)) != baseResearchProjects.end())
-		{
-			continue;
-		}
-		if (research->needItem() && base->getStorageItems()->getItem(research->getName()) == 0)
-		{
-			continue;
-		}
-		if (!research->getRequirements().empty())
+	const std::vector<ResearchProject *> & baseResearchProjects = base->getResearch();
+	if (std::find_if (baseResearchProjects.begin(), baseResearchProjects.end(), findRuleResearch(research)) != baseResearchProjects.end())
+	{
+		return false;
+	}
+	if (research->needItem() && base->getStorageItems()->getItem(research->getName()) == 0)
+	{
+		return false;
+	}
+	for (std::vector<std::string>::const_iterator itreq = research->getRequirements().begin(); itreq != research->getRequirements().end(); ++itreq)
+	{
+		if (!isDiscovered(mod->getResearch(*itreq)))
 		{
-			size_t tally(0);
-			for (size_t itreq = 0; itreq != research->getRequirements().size(); ++itreq)
-			{
-				itDiscovered = std::find(discovered.begin(), discovered.end(), mod->getResearch(research->getRequirements().at(itreq)));
-				if (itDiscovered != discovered.end())
-				{
-					tally++;
-				}
-			}
-			if (tally != research->getRequirements().size())
-				continue;
+			return false;
 		}
-		projects.push_back (research);
 	}
+	return true;
 }
 
 /**
@@ -1264,16 +1290,15 @@ void SavedGame::getAvailableProductions (std::vector<RuleManufacture *> & produc
  * @param mod the current Mod
  * @return true if the RuleResearch can be researched
  */
-bool SavedGame::isResearchAvailable (RuleResearch * r, const std::vector<const RuleResearch *> & unlocked, const Mod * mod) const
+bool SavedGame::isResearchAvailable (RuleResearch * r, const std::set<const RuleResearch *> & unlocked, const Mod * mod) const
 {
 	if (r == 0)
 	{
 		return false;
 	}
-	std::vector<std::string> deps = r->getDependencies();
-	const std::vector<const RuleResearch *> & discovered(getDiscoveredResearch());
+	const std::vector<std::string> &deps = r->getDependencies();
 	bool liveAlien = mod->getUnit(r->getName()) != 0;
-	if (_debug || std::find(unlocked.begin(), unlocked.end(), r) != unlocked.end())
+	if (_debug || unlocked.find(r) != unlocked.end())
 	{
 		return true;
 	}
@@ -1287,24 +1312,16 @@ bool SavedGame::isResearchAvailable (RuleResearch * r, const std::vector<const R
 			bool leader ( leaderCheck != r->getUnlocked().end());
 			bool cmnder ( cmnderCheck != r->getUnlocked().end());
 
-			if (leader)
-			{
-				std::vector<const RuleResearch*>::const_iterator found = std::find(discovered.begin(), discovered.end(), mod->getResearch("STR_LEADER_PLUS"));
-				if (found == discovered.end())
-					return true;
-			}
+			if (leader && !isDiscovered(mod->getResearch("STR_LEADER_PLUS")))
+				return true;
 
-			if (cmnder)
-			{
-				std::vector<const RuleResearch*>::const_iterator found = std::find(discovered.begin(), discovered.end(), mod->getResearch("STR_COMMANDER_PLUS"));
-				if (found == discovered.end())
-					return true;
-			}
+			if (cmnder && !isDiscovered(mod->getResearch("STR_COMMANDER_PLUS")))
+				return true;
 		}
 	}
 	for (std::vector<std::string>::const_iterator itFree = r->getGetOneFree().begin(); itFree != r->getGetOneFree().end(); ++itFree)
 	{
-		if (std::find(unlocked.begin(), unlocked.end(), mod->getResearch(*itFree)) == unlocked.end())
+		if (unlocked.find(mod->getResearch(*itFree)) == unlocked.end())
 		{
 			return true;
 		}
@@ -1312,9 +1329,7 @@ bool SavedGame::isResearchAvailable (RuleResearch * r, const std::vector<const R
 
 	for (std::vector<std::string>::const_iterator iter = deps.begin(); iter != deps.end(); ++ iter)
 	{
-		RuleResearch *research = mod->getResearch(*iter);
-		std::vector<const RuleResearch *>::const_iterator itDiscovered = std::find(discovered.begin(), discovered.end(), research);
-		if (itDiscovered == discovered.end())
+		if (!isDiscovered(mod->getResearch(*iter)))
 		{
 			return false;
 		}
@@ -1332,14 +1347,16 @@ bool SavedGame::isResearchAvailable (RuleResearch * r, const std::vector<const R
  */
 void SavedGame::getDependableResearch (std::vector<RuleResearch *> & dependables, const RuleResearch *research, const Mod * mod, Base * base) const
 {
-	getDependableResearchBasic(dependables, research, mod, base);
+	std::set<const RuleResearch *> unlocked;
+	getUnlockedResearch(unlocked, mod);
+	getDependableResearchBasic(dependables, research, mod, base, unlocked);
 	for (std::vector<const RuleResearch *>::const_iterator iter = _discovered.begin(); iter != _discovered.end(); ++iter)
 	{
 		if ((*iter)->getCost() == 0)
 		{
 			if (std::find((*iter)->getDependencies().begin(), (*iter)->getDependencies().end(), research->getName()) != (*iter)->getDependencies().end())
 			{
-				getDependableResearchBasic(dependables, *iter, mod, base);
+				getDependableResearchBasic(dependables, *iter, mod, base, unlocked);
 			}
 		}
 	}
@@ -1347,24 +1364,24 @@ void SavedGame::getDependableResearch (std::vector<RuleResearch *> & dependables
 
 /**
  * Get the list of newly available research projects once a ResearchProject has been completed. This function doesn't check for fake ResearchProject.
+ * Only the projects that depend on or are unlocked by the research are checked.
  * @param dependables the list of RuleResearch which are now available.
  * @param research The RuleResearch which has just been discovered
  * @param mod the Game Mod
  * @param base a pointer to a Base
+ * @param unlocked the set of currently unlocked RuleResearch
  */
-void SavedGame::getDependableResearchBasic (std::vector<RuleResearch *> & dependables, const RuleResearch *research, const Mod * mod, Base * base) const
+void SavedGame::getDependableResearchBasic (std::vector<RuleResearch *> & dependables, const RuleResearch *research, const Mod * mod, Base * base, const std::set<const RuleResearch *> & unlocked) const
 {
-	std::vector<RuleResearch *> possibleProjects;
-	getAvailableResearchProjects(possibleProjects, mod, base);
-	for (std::vector<RuleResearch *>::iterator iter = possibleProjects.begin(); iter != possibleProjects.end(); ++iter)
+	const std::vector<RuleResearch *> &candidates = mod->getResearchDependents(research->getName());
+	for (std::vector<RuleResearch *>::const_iterator iter = candidates.begin(); iter != candidates.end(); ++iter)
 	{
-		if (std::find((*iter)->getDependencies().begin(), (*iter)->getDependencies().end(), research->getName()) != (*iter)->getDependencies().end()
-			|| std::find((*iter)->getUnlocked().begin(), (*iter)->getUnlocked().end(), research->getName()) != (*iter)->getUnlocked().end())
+		if (isResearchProjectAvailable(*iter, unlocked, mod, base))
 		{
 			dependables.push_back(*iter);
 			if ((*iter)->getCost() == 0)
 			{
-				getDependableResearchBasic(dependables, *iter, mod, base);
+				getDependableResearchBasic(dependables, *iter, mod, base, unlocked);
 			}
 		}
 	}
@@ -1379,14 +1396,12 @@ void SavedGame::getDependableResearchBasic (std::vector<RuleResearch *> & depend
  */
 void SavedGame::getDependableManufacture (std::vector<RuleManufacture *> & dependables, const RuleResearch *research, const Mod * mod, Base *) const
 {
-	const std::vector<std::string> &mans = mod->getManufactureList();
-	for (std::vector<std::string>::const_iterator iter = mans.begin(); iter != mans.end(); ++iter)
+	const std::vector<RuleManufacture *> &mans = mod->getManufactureDependents(research->getName());
+	for (std::vector<RuleManufacture *>::const_iterator iter = mans.begin(); iter != mans.end(); ++iter)
 	{
-		RuleManufacture *m = mod->getManufacture(*iter);
-		const std::vector<std::string> &reqs = m->getRequirements();
-		if (isResearched(m->getRequirements()) && std::find(reqs.begin(), reqs.end(), research->getName()) != reqs.end())
+		if (isResearched((*iter)->getRequirements()))
 		{
-			dependables.push_back(m);
+			dependables.push_back(*iter);
 		}
 	}
 }
@@ -1400,13 +1415,7 @@ bool SavedGame::isResearched(const std::string &research) const
 {
 	if (research.empty() || _debug)
 		return true;
-	for (std::vector<const RuleResearch *>::const_iterator i = _discovered.begin(); i != _discovered.end(); ++i)
-	{
-		if ((*i)->getName() == research)
-			return true;
-	}
-
-	return false;
+	return _discoveredNames.find(research) != _discoveredNames.end();
 }
 
 /**
@@ -1418,22 +1427,13 @@ bool SavedGame::isResearched(const std::vector<std::string> &research) const
 {
 	if (research.empty() || _debug)
 		return true;
-	std::vector<std::string> matches = research;
-	for (std::vector<const RuleResearch *>::const_iterator i = _discovered.begin(); i != _discovered.end(); ++i)
+	for (std::vector<std::string>::const_iterator i = research.begin(); i != research.end(); ++i)
 	{
-		for (std::vector<std::string>::iterator j = matches.begin(); j != matches.end(); ++j)
-		{
-			if ((*i)->getName() == *j)
-			{
-				j = matches.erase(j);
-				break;
-			}
-		}
-		if (matches.empty())
-			return true;
+		if (_discoveredNames.find(*i) == _discoveredNames.end())
+			return false;
 	}
 
-	return false;
+	return true;
 }
 
 /**
@@ -1780,10 +1780,31 @@ private:
  */
 Region *SavedGame::locateRegion(double lon, double lat) const
 {
-	std::vector<Region *>::const_iterator found = std::find_if (_regions.begin(), _regions.end(), ContainsPoint(lon, lat));
-	if (found != _regions.end())
+	if (_regionIndex.size() != _regions.size())
+	{
+		_regionIndex.clear();
+		for (std::vector<Region*>::const_iterator i = _regions.begin(); i != _regions.end(); ++i)
+		{
+			const RuleRegion *rules = (*i)->getRules();
+			_regionIndex.add(rules->getLonMin(), rules->getLonMax(), rules->getLatMin(), rules->getLatMax());
+		}
+	}
+	const std::vector<size_t> *candidates = _regionIndex.getCandidates(lon, lat);
+	if (candidates == 0)
 	{
-		return *found;
+		std::vector<Region *>::const_iterator found = std::find_if (_regions.begin(), _regions.end(), ContainsPoint(lon, lat));
+		if (found != _regions.end())
+		{
+			return *found;
+		}
+		return 0;
+	}
+	for (std::vector<size_t>::const_iterator i = candidates->begin(); i != candidates->end(); ++i)
+	{
+		if (_regions[*i]->getRules()->insideRegion(lon, lat))
+		{
+			return _regions[*i];
+		}
 	}
 	return 0;
 }
@@ -1798,6 +1819,55 @@ Region *SavedGame::locateRegion(const Target &target) const
 	return locateRegion(target.getLongitude(), target.getLatitude());
 }
 
+/**
+ * Find the country containing this location.
+ * @param lon The longtitude.
+ * @param lat The latitude.
+ * @return Pointer to the country, or 0.
+ */
+Country *SavedGame::locateCountry(double lon, double lat) const
+{
+	if (_countryIndex.size() != _countries.size())
+	{
+		_countryIndex.clear();
+		for (std::vector<Country*>::const_iterator i = _countries.begin(); i != _countries.end(); ++i)
+		{
+			const RuleCountry *rules = (*i)->getRules();
+			_countryIndex.add(rules->getLonMin(), rules->getLonMax(), rules->getLatMin(), rules->getLatMax());
+		}
+	}
+	const std::vector<size_t> *candidates = _countryIndex.getCandidates(lon, lat);
+	if (candidates == 0)
+	{
+		for (std::vector<Country*>::const_iterator i = _countries.begin(); i != _countries.end(); ++i)
+		{
+			if ((*i)->getRules()->insideCountry(lon, lat))
+			{
+				return *i;
+			}
+		}
+		return 0;
+	}
+	for (std::vector<size_t>::const_iterator i = candidates->begin(); i != candidates->end(); ++i)
+	{
+		if (_countries[*i]->getRules()->insideCountry(lon, lat))
+		{
+			return _countries[*i];
+		}
+	}
+	return 0;
+}
+
+/**
+ * Find the country containing this target.
+ * @param target The target to locate.
+ * @return Pointer to the country, or 0.
+ */
+Country *SavedGame::locateCountry(const Target &target) const
+{
+	return locateCountry(target.getLongitude(), target.getLatitude());
+}
+
 /*
  * @return the month counter.
  */
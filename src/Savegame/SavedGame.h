@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <map>
+#include <set>
 #include <vector>
 #include <string>
 #include <time.h>
@@ -25,6 +26,7 @@
 #include "GameTime.h"
 #include "../Mod/RuleAlienMission.h"
 #include "../Savegame/Craft.h"
+#include "AreaIndex.h"
 
 namespace OpenXcom
 {
@@ -111,6 +113,7 @@ private:
 	std::map<std::string, int> _ids;
 	std::vector<Country*> _countries;
 	std::vector<Region*> _regions;
+	mutable AreaIndex _countryIndex, _regionIndex;
 	std::vector<Base*> _bases;
 	std::vector<Ufo*> _ufos;
 	std::vector<Waypoint*> _waypoints;
@@ -119,6 +122,8 @@ private:
 	AlienStrategy *_alienStrategy;
 	SavedBattleGame *_battleGame;
 	std::vector<const RuleResearch*> _discovered;
+	std::set<const RuleResearch*> _discoveredSet;
+	std::set<std::string> _discoveredNames;
 	std::vector<AlienMission*> _activeMissions;
 	bool _debug, _warned;
 	int _monthsPassed;
@@ -131,7 +136,13 @@ private:
 	std::string _lastselectedArmor; //contains the last selected armour
 	std::vector<MissionStatistics*> _missionStatistics;
 
-	void getDependableResearchBasic (std::vector<RuleResearch*> & dependables, const RuleResearch *research, const Mod *mod, Base *base) const;
+	void getDependableResearchBasic (std::vector<RuleResearch*> & dependables, const RuleResearch *research, const Mod *mod, Base *base, const std::set<const RuleResearch*> &unlocked) const;
+	/// Gets the set of research unlocked by discovered research.
+	void getUnlockedResearch(std::set<const RuleResearch*> &unlocked, const Mod *mod) const;
+	/// Checks whether a research project can be started in a base.
+	bool isResearchProjectAvailable(RuleResearch *research, const std::set<const RuleResearch*> &unlocked, const Mod *mod, Base *base) const;
+	/// Checks whether a research has been discovered.
+	bool isDiscovered(const RuleResearch *research) const;
 	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
 public:
 	static const std::string AUTOSAVE_GEOSCAPE, AUTOSAVE_BATTLESCAPE, QUICKSAVE;
@@ -228,7 +239,7 @@ public:
 	/// Get the list of newly available manufacture projects once a research has been completed.
 	void getDependableManufacture(std::vector<RuleManufacture*> & dependables, const RuleResearch *research, const Mod *mod, Base *base) const;
 	/// Check whether a ResearchProject can be researched
-	bool isResearchAvailable(RuleResearch *r, const std::vector<const RuleResearch*> & unlocked, const Mod *mod) const;
+	bool isResearchAvailable(RuleResearch *r, const std::set<const RuleResearch*> & unlocked, const Mod *mod) const;
 	/// Gets if a research has been unlocked.
 	bool isResearched(const std::string &research) const;
 	/// Gets if a list of research has been unlocked.
@@ -275,6 +286,10 @@ public:
 	Region *locateRegion(double lon, double lat) const;
 	/// Locate a region containing a Target.
 	Region *locateRegion(const Target &target) const;
+	/// Locate a country containing a position.
+	Country *locateCountry(double lon, double lat) const;
+	/// Locate a country containing a Target.
+	Country *locateCountry(const Target &target) const;
 	/// Return the month counter.
 	int getMonthsPassed() const;
 	/// Return the GraphRegionToggles.
@@ -67,6 +67,7 @@ SoldierDiary::~SoldierDiary()
  */
 void SoldierDiary::load(const YAML::Node& node)
 {
+	_totals = SoldierDiaryTotals();
 	if (const YAML::Node &commendations = node["commendations"])
 	{
 		for (YAML::const_iterator i = commendations.begin(); i != commendations.end(); ++i)
@@ -171,6 +172,10 @@ void SoldierDiary::updateDiary(BattleUnitStatistics *unitStatistics, std::vector
 	{
 		(*kill)->makeTurnUnique();
 		_killList.push_back(*kill);
+		if (_totals.killsValid)
+		{
+			addKillTotals(*kill);
+		}
 	}
 	unitKills.clear();
 	if (missionStatistics->success)
@@ -205,11 +210,12 @@ void SoldierDiary::updateDiary(BattleUnitStatistics *unitStatistics, std::vector
 	if (unitStatistics->MIA)
 		_MIA++;
 	_woundsHealedTotal = unitStatistics->woundsHealed++;
-	if (getUFOTotal(allMissionStatistics).size() >= rules->getUfosList().size())
+	updateMissionTotals(allMissionStatistics);
+	if (_totals.ufo.size() >= rules->getUfosList().size())
 		_allUFOs = 1;
-	if ((getUFOTotal(allMissionStatistics).size() + getTypeTotal(allMissionStatistics).size()) == (rules->getUfosList().size() + rules->getDeploymentsList().size() - 2))
+	if ((_totals.ufo.size() + _totals.type.size()) == (rules->getUfosList().size() + rules->getDeploymentsList().size() - 2))
 		_allMissionTypes = 1;
-	if (getCountryTotal(allMissionStatistics).size() == rules->getCountriesList().size())
+	if (_totals.country.size() == rules->getCountriesList().size())
 		_globeTrotter = true;
 	_martyrKillsTotal += unitStatistics->martyr;
 	_slaveKillsTotal += unitStatistics->slaveKills;
@@ -232,6 +238,135 @@ void SoldierDiary::updateDiary(BattleUnitStatistics *unitStatistics, std::vector
 	_revivedUnitTotal += unitStatistics->revivedSoldier;
 	_wholeMedikitTotal += std::min( std::min(unitStatistics->woundsHealed, unitStatistics->appliedStimulant), unitStatistics->appliedPainKill);
 	_missionIdList.push_back(missionStatistics->id);
+	addMissionTotals(missionStatistics);
+}
+
+/**
+ * Adds a kill to the running kill totals.
+ * @param kill Kill to add.
+ */
+void SoldierDiary::addKillTotals(const BattleUnitKills *kill) const
+{
+	_totals.rank[kill->rank]++;
+	_totals.race[kill->race]++;
+	if (kill->faction == FACTION_HOSTILE)
+	{
+		_totals.weapon[kill->weapon]++;
+		_totals.weaponAmmo[kill->weaponAmmo]++;
+		switch (kill->status)
+		{
+		case STATUS_DEAD:
+			_totals.kills++;
+			break;
+		case STATUS_UNCONSCIOUS:
+			_totals.stuns++;
+			break;
+		case STATUS_PANICKING:
+			_totals.panicks++;
+			break;
+		case STATUS_TURNING:
+			_totals.controls++;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/**
+ * Adds a mission the soldier took part in to the running mission totals.
+ * @param mission Statistics of the mission to add.
+ */
+void SoldierDiary::addMissionTotals(const MissionStatistics *mission) const
+{
+	_totals.region[mission->region]++;
+	_totals.country[mission->country]++;
+	_totals.type[mission->type]++;
+	_totals.ufo[mission->ufo]++;
+	_totals.score += mission->score;
+	_totals.lootValue += mission->lootValue;
+	if (mission->valiantCrux)
+		_totals.valiantCrux++;
+	if (mission->success)
+	{
+		_totals.wins++;
+		bool night = mission->daylight > 5;
+		if (mission->isBaseDefense())
+		{
+			_totals.baseDefenseMissions++;
+		}
+		else if (mission->isAlienBase())
+		{
+			_totals.alienBaseAssaults++;
+		}
+		else
+		{
+			if (night)
+				_totals.nightMissions++;
+			if (!mission->isUfoMission())
+			{
+				_totals.terrorMissions++;
+				if (night)
+					_totals.nightTerrorMissions++;
+			}
+		}
+		if (mission->type != "STR_UFO_CRASH_RECOVERY")
+			_totals.importantMissions++;
+	}
+}
+
+/**
+ * Builds the kill totals from the whole kill list,
+ * unless they're already being kept up to date.
+ */
+void SoldierDiary::updateKillTotals() const
+{
+	if (_totals.killsValid)
+		return;
+	_totals.rank.clear();
+	_totals.race.clear();
+	_totals.weapon.clear();
+	_totals.weaponAmmo.clear();
+	_totals.kills = _totals.stuns = _totals.panicks = _totals.controls = 0;
+	for (std::vector<BattleUnitKills*>::const_iterator i = _killList.begin(); i != _killList.end(); ++i)
+	{
+		addKillTotals(*i);
+	}
+	_totals.killsValid = true;
+}
+
+/**
+ * Builds the mission totals from the mission history,
+ * unless they're already being kept up to date.
+ * @param missionStatistics List of all the missions in the campaign.
+ */
+void SoldierDiary::updateMissionTotals(std::vector<MissionStatistics*> *missionStatistics) const
+{
+	if (_totals.missionsValid)
+		return;
+	_totals.region.clear();
+	_totals.country.clear();
+	_totals.type.clear();
+	_totals.ufo.clear();
+	_totals.wins = _totals.score = _totals.terrorMissions = _totals.nightMissions = _totals.nightTerrorMissions = 0;
+	_totals.baseDefenseMissions = _totals.alienBaseAssaults = _totals.importantMissions = _totals.valiantCrux = _totals.lootValue = 0;
+	std::map<int, int> missionCount;
+	for (std::vector<int>::const_iterator i = _missionIdList.begin(); i != _missionIdList.end(); ++i)
+	{
+		missionCount[*i]++;
+	}
+	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
+	{
+		std::map<int, int>::const_iterator count = missionCount.find((*i)->id);
+		if (count != missionCount.end())
+		{
+			for (int j = 0; j < count->second; ++j)
+			{
+				addMissionTotals(*i);
+			}
+		}
+	}
+	_totals.missionsValid = true;
 }
 
 /**
@@ -260,6 +395,55 @@ bool SoldierDiary::manageCommendations(Mod *mod, std::vector<MissionStatistics*>
 	std::map<std::string, int> nextCommendationLevel;   // Noun, threshold.
 	std::vector<std::string> modularCommendations;      // Commendation name.
 	bool awardCommendationBool = false;                 // This value determines if a commendation will be given.
+
+	// None of the totals change while awarding, so look them all up once.
+	updateKillTotals();
+	updateMissionTotals(missionStatistics);
+	std::map<std::string, int> totals;
+	std::map<std::string, int>::const_iterator total;
+	totals["totalKills"] = _totals.kills;
+	totals["totalMissions"] = _missionIdList.size();
+	totals["totalWins"] = _totals.wins;
+	totals["totalScore"] = _totals.score;
+	totals["totalStuns"] = _totals.stuns;
+	totals["totalDaysWounded"] = _daysWoundedTotal;
+	totals["totalBaseDefenseMissions"] = _totals.baseDefenseMissions;
+	totals["totalTerrorMissions"] = _totals.terrorMissions;
+	totals["totalNightMissions"] = _totals.nightMissions;
+	totals["totalNightTerrorMissions"] = _totals.nightTerrorMissions;
+	totals["totalMonthlyService"] = _monthsService;
+	totals["totalFellUnconcious"] = _unconciousTotal;
+	totals["totalShotAt10Times"] = _shotAtCounter10in1Mission;
+	totals["totalHit5Times"] = _hitCounter5in1Mission;
+	totals["totalFriendlyFired"] = _totalShotByFriendlyCounter;
+	totals["total_lone_survivor"] = _loneSurvivorTotal;
+	totals["totalIronMan"] = _ironManTotal;
+	totals["totalImportantMissions"] = _totals.importantMissions;
+	totals["totalLongDistanceHits"] = _longDistanceHitCounterTotal;
+	totals["totalLowAccuracyHits"] = _lowAccuracyHitCounterTotal;
+	totals["totalReactionFire"] = getReactionFireKillTotal(mod);
+	totals["totalTimesWounded"] = _timesWoundedTotal;
+	totals["totalValientCrux"] = _totals.valiantCrux;
+	totals["isDead"] = _KIA;
+	totals["totalTrapKills"] = getTrapKillTotal(mod);
+	totals["totalAlienBaseAssaults"] = _totals.alienBaseAssaults;
+	totals["totalAllAliensKilled"] = _allAliensKilledTotal;
+	totals["totalAllAliensStunned"] = _allAliensStunnedTotal;
+	totals["totalWoundsHealed"] = _woundsHealedTotal;
+	totals["totalAllUFOs"] = _allUFOs;
+	totals["totalAllMissionTypes"] = _allMissionTypes;
+	totals["totalStatGain"] = _statGainTotal;
+	totals["totalRevives"] = _revivedUnitTotal;
+	totals["totalWholeMedikit"] = _wholeMedikitTotal;
+	totals["totalBraveryGain"] = _braveryGainTotal;
+	totals["bestOfRank"] = _bestOfRank;
+	totals["bestSoldier"] = (int)_bestSoldier;
+	totals["isMIA"] = _MIA;
+	totals["totalMartyrKills"] = _martyrKillsTotal;
+	totals["totalPostMortemKills"] = _postMortemKills;
+	totals["globeTrotter"] = (int)_globeTrotter;
+	totals["totalSlaveKills"] = _slaveKillsTotal;
+
 	// Loop over all possible commendations
 	for (std::map<std::string, RuleCommendations *>::iterator i = commendationsList.begin(); i != commendationsList.end(); )
 	{
@@ -287,51 +471,9 @@ bool SoldierDiary::manageCommendations(Mod *mod, std::vector<MissionStatistics*>
 				break;
 			}
 			// These criteria have no nouns, so only the nextCommendationLevel["noNoun"] will ever be used.
-			else if( nextCommendationLevel.count("noNoun") == 1 &&
-				  ( ((*j).first == "totalKills" && (unsigned int)getKillTotal() < (unsigned int)(*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalMissions" && _missionIdList.size() < (unsigned int)(*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalWins" && getWinTotal(missionStatistics) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalScore" && getScoreTotal(missionStatistics) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalStuns" && getStunTotal() < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalDaysWounded" && _daysWoundedTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalBaseDefenseMissions" && getBaseDefenseMissionTotal(missionStatistics) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalTerrorMissions" && getTerrorMissionTotal(missionStatistics) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalNightMissions" && getNightMissionTotal(missionStatistics) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalNightTerrorMissions" && getNightTerrorMissionTotal(missionStatistics) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalMonthlyService" && _monthsService < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalFellUnconcious" && _unconciousTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalShotAt10Times" && _shotAtCounter10in1Mission < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalHit5Times" && _hitCounter5in1Mission < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalFriendlyFired" && (_totalShotByFriendlyCounter < (*j).second.at(nextCommendationLevel["noNoun"]) || _KIA || _MIA)) ||
-					((*j).first == "total_lone_survivor" && _loneSurvivorTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalIronMan" && _ironManTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalImportantMissions" && getImportantMissionTotal(missionStatistics) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalLongDistanceHits" && _longDistanceHitCounterTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalLowAccuracyHits" && _lowAccuracyHitCounterTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalReactionFire" && getReactionFireKillTotal(mod) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalTimesWounded" && _timesWoundedTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalDaysWounded" && _daysWoundedTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalValientCrux" && getValiantCruxTotal(missionStatistics) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "isDead" && _KIA < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalTrapKills" && getTrapKillTotal(mod) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalAlienBaseAssaults" && getAlienBaseAssaultTotal(missionStatistics) < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalAllAliensKilled" && _allAliensKilledTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalAllAliensStunned" && _allAliensStunnedTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalWoundsHealed" && _woundsHealedTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalAllUFOs" && _allUFOs < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalAllMissionTypes" && _allMissionTypes < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalStatGain" && _statGainTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalRevives" && _revivedUnitTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalWholeMedikit" && _wholeMedikitTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalBraveryGain" && _braveryGainTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "bestOfRank" && _bestOfRank < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "bestSoldier" && (int)_bestSoldier < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "isMIA" && _MIA < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalMartyrKills" && _martyrKillsTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalPostMortemKills" && _postMortemKills < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "globeTrotter" && (int)_globeTrotter < (*j).second.at(nextCommendationLevel["noNoun"])) ||
-					((*j).first == "totalSlaveKills" && _slaveKillsTotal < (*j).second.at(nextCommendationLevel["noNoun"])) ) )
-					
+			else if ((total = totals.find((*j).first)) != totals.end() &&
+				(total->second < (*j).second.at(nextCommendationLevel["noNoun"]) ||
+				((*j).first == "totalFriendlyFired" && (_KIA || _MIA))))
 			{
 				awardCommendationBool = false;
 				break;
@@ -340,18 +482,18 @@ bool SoldierDiary::manageCommendations(Mod *mod, std::vector<MissionStatistics*>
 			// And because they loop over a map<> (this allows for maximum moddability).
 			else if ((*j).first == "totalKillsWithAWeapon" || (*j).first == "totalMissionsInARegion" || (*j).first == "totalKillsByRace" || (*j).first == "totalKillsByRank")
 			{
-				std::map<std::string, int> tempTotal;
+				const std::map<std::string, int> *tempTotal;
 				if ((*j).first == "totalKillsWithAWeapon")
-					tempTotal = getWeaponTotal();
+					tempTotal = &_totals.weapon;
 				else if ((*j).first == "totalMissionsInARegion")
-					tempTotal = getRegionTotal(missionStatistics);
+					tempTotal = &_totals.region;
 				else if ((*j).first == "totalKillsByRace")
-					tempTotal = getAlienRaceTotal();
-				else if ((*j).first == "totalKillsByRank")
-					tempTotal = getAlienRankTotal();
+					tempTotal = &_totals.race;
+				else
+					tempTotal = &_totals.rank;
 				// Loop over the temporary map.
 				// Match nouns and decoration levels.
-				for(std::map<std::string, int>::const_iterator k = tempTotal.begin(); k != tempTotal.end(); ++k)
+				for(std::map<std::string, int>::const_iterator k = tempTotal->begin(); k != tempTotal->end(); ++k)
 				{
 					int criteria = -1;
 					std::string noun = (*k).first;
@@ -400,6 +542,32 @@ bool SoldierDiary::manageCommendations(Mod *mod, std::vector<MissionStatistics*>
 						
 						if ((*j).first == "killsWithCriteriaTurn" || (*j).first == "killsWithCriteriaMission")
 							detailCount++; // Turns and missions start at 1 because of how thisTime and lastTime work.
+
+						// Resolve the battle and damage types of the DETAILs once, not for every kill.
+						std::vector<int> battleTypes, damageTypes;
+						for (std::vector<std::string>::const_iterator detail = andCriteria->second.begin(); detail != andCriteria->second.end(); ++detail)
+						{
+							int battleType = 0;
+							int damageType = 0;
+
+							for (; battleType != BATTLE_TYPES; ++battleType)
+							{
+								if ((*detail) == battleTypeArray[battleType])
+								{
+									break;
+								}
+							}
+
+							for (; damageType != DAMAGE_TYPES; ++damageType)
+							{
+								if ((*detail) == damageTypeArray[damageType])
+								{
+									break;
+								}
+							}
+							battleTypes.push_back(battleType);
+							damageTypes.push_back(damageType);
+						}
 												
 						// Loop over the KILLS.
 						for (std::vector<BattleUnitKills*>::const_iterator singleKill = _killList.begin(); singleKill != _killList.end(); ++singleKill)
@@ -439,31 +607,15 @@ bool SoldierDiary::manageCommendations(Mod *mod, std::vector<MissionStatistics*>
 								continue;
 							}
 							
+							RuleItem *weapon = mod->getItem((*singleKill)->weapon);
+							RuleItem *weaponAmmo = mod->getItem((*singleKill)->weaponAmmo);
 							// Loop over the DETAILs of one AND vector.
 							for (std::vector<std::string>::const_iterator detail = andCriteria->second.begin(); detail != andCriteria->second.end(); ++detail)
 							{
-								int battleType = 0;
-								int damageType = 0;
-								
-								for (; battleType != BATTLE_TYPES; ++battleType)
-								{
-									if ((*detail) == battleTypeArray[battleType])
-									{
-										break;
-									}
-								}
-
-								for (; damageType != DAMAGE_TYPES; ++damageType)
-								{
-									if ((*detail) == damageTypeArray[damageType])
-									{
-										break;
-									}
-								}
+								int battleType = battleTypes[detail - andCriteria->second.begin()];
+								int damageType = damageTypes[detail - andCriteria->second.begin()];
 
 								// See if we find _no_ matches with any criteria. If so, break and try the next kill.
-								RuleItem *weapon = mod->getItem((*singleKill)->weapon);
-								RuleItem *weaponAmmo = mod->getItem((*singleKill)->weaponAmmo);
 								if (weapon == 0 || weaponAmmo == 0 ||
 									((*singleKill)->rank != (*detail) && (*singleKill)->race != (*detail) &&
 									 (*singleKill)->weapon != (*detail) && (*singleKill)->weaponAmmo != (*detail) &&
@@ -604,12 +756,8 @@ std::vector<BattleUnitKills*> &SoldierDiary::getKills()
  */
 std::map<std::string, int> SoldierDiary::getAlienRankTotal()
 {
-	std::map<std::string, int> list;
-	for(std::vector<BattleUnitKills*>::const_iterator kill = _killList.begin(); kill != _killList.end(); ++kill)
-	{
-		list[(*kill)->rank]++;
-	}
-	return list;
+	updateKillTotals();
+	return _totals.rank;
 }
 
 /**
@@ -617,12 +765,8 @@ std::map<std::string, int> SoldierDiary::getAlienRankTotal()
  */
 std::map<std::string, int> SoldierDiary::getAlienRaceTotal()
 {
-	std::map<std::string, int> list;
-	for(std::vector<BattleUnitKills*>::const_iterator kill = _killList.begin(); kill != _killList.end(); ++kill)
-	{
-		list[(*kill)->race]++;
-	}
-	return list;
+	updateKillTotals();
+	return _totals.race;
 }
 
 /**
@@ -630,13 +774,8 @@ std::map<std::string, int> SoldierDiary::getAlienRaceTotal()
  */
 std::map<std::string, int> SoldierDiary::getWeaponTotal()
 {
-	std::map<std::string, int> list;
-	for(std::vector<BattleUnitKills*>::const_iterator kill = _killList.begin(); kill != _killList.end(); ++kill)
-	{
-		if ((*kill)->faction == FACTION_HOSTILE)
-			list[(*kill)->weapon]++;
-	}
-	return list;
+	updateKillTotals();
+	return _totals.weapon;
 }
 
 /**
@@ -644,13 +783,8 @@ std::map<std::string, int> SoldierDiary::getWeaponTotal()
  */
 std::map<std::string, int> SoldierDiary::getWeaponAmmoTotal()
 {
-	std::map<std::string, int> list;
-	for(std::vector<BattleUnitKills*>::const_iterator kill = _killList.begin(); kill != _killList.end(); ++kill)
-	{
-		if ((*kill)->faction == FACTION_HOSTILE)
-			list[(*kill)->weaponAmmo]++;
-	}
-	return list;
+	updateKillTotals();
+	return _totals.weaponAmmo;
 }
 
 /**
@@ -659,20 +793,8 @@ std::map<std::string, int> SoldierDiary::getWeaponAmmoTotal()
  */
 std::map<std::string, int> SoldierDiary::getRegionTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	std::map<std::string, int> regionTotal;
-
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				regionTotal[(*i)->region]++;
-			}
-		}
-	}
-
-	return regionTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.region;
 }
 
 /**
@@ -681,20 +803,8 @@ std::map<std::string, int> SoldierDiary::getRegionTotal(std::vector<MissionStati
  */
 std::map<std::string, int> SoldierDiary::getCountryTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	std::map<std::string, int> countryTotal;
-
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				countryTotal[(*i)->country]++;
-			}
-		}
-	}
-
-	return countryTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.country;
 }
 
 /**
@@ -703,20 +813,8 @@ std::map<std::string, int> SoldierDiary::getCountryTotal(std::vector<MissionStat
  */
 std::map<std::string, int> SoldierDiary::getTypeTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	std::map<std::string, int> typeTotal;
-
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				typeTotal[(*i)->type]++;
-			}
-		}
-	}
-
-	return typeTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.type;
 }
 
 /**
@@ -725,20 +823,8 @@ std::map<std::string, int> SoldierDiary::getTypeTotal(std::vector<MissionStatist
  */
 std::map<std::string, int> SoldierDiary::getUFOTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	std::map<std::string, int> ufoTotal;
-
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				ufoTotal[(*i)->ufo]++;
-			}
-		}
-	}
-
-	return ufoTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.ufo;
 }
 
 /**
@@ -746,17 +832,8 @@ std::map<std::string, int> SoldierDiary::getUFOTotal(std::vector<MissionStatisti
  */
 int SoldierDiary::getKillTotal() const
 {
-	int killTotal = 0;
-		
-	for (std::vector<BattleUnitKills*>::const_iterator i = _killList.begin(); i != _killList.end(); ++i)
-	{
-		if ((*i)->status == STATUS_DEAD && (*i)->faction == FACTION_HOSTILE)
-		{
-			killTotal++;
-		}
-	}
-	
-	return killTotal;
+	updateKillTotals();
+	return _totals.kills;
 }
 
 /**
@@ -773,23 +850,8 @@ int SoldierDiary::getMissionTotal() const
  */
 int SoldierDiary::getWinTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int winTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				if ((*i)->success)
-				{
-					winTotal++;
-				}
-			}
-		}
-	}
-	
-	return winTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.wins;
 }
 
 /**
@@ -797,17 +859,8 @@ int SoldierDiary::getWinTotal(std::vector<MissionStatistics*> *missionStatistics
  */
 int SoldierDiary::getStunTotal() const
 {
-	int stunTotal = 0;
-	
-	for (std::vector<BattleUnitKills*>::const_iterator i = _killList.begin(); i != _killList.end(); ++i)
-	{
-		if ((*i)->status == STATUS_UNCONSCIOUS && (*i)->faction == FACTION_HOSTILE)
-		{
-			stunTotal++;
-		}
-	}
-	
-	return stunTotal;
+	updateKillTotals();
+	return _totals.stuns;
 }
 
 /**
@@ -815,17 +868,8 @@ int SoldierDiary::getStunTotal() const
  */
 int SoldierDiary::getPanickTotal() const
 {
-	int panickTotal = 0;
-	
-	for (std::vector<BattleUnitKills*>::const_iterator i = _killList.begin(); i != _killList.end(); ++i)
-	{
-		if ((*i)->status == STATUS_PANICKING && (*i)->faction == FACTION_HOSTILE)
-		{
-			panickTotal++;
-		}
-	}
-	
-	return panickTotal;
+	updateKillTotals();
+	return _totals.panicks;
 }
 
 /**
@@ -833,17 +877,8 @@ int SoldierDiary::getPanickTotal() const
  */
 int SoldierDiary::getControlTotal() const
 {
-	int controlTotal = 0;
-	
-	for (std::vector<BattleUnitKills*>::const_iterator i = _killList.begin(); i != _killList.end(); ++i)
-	{
-		if ((*i)->status == STATUS_TURNING && (*i)->faction == FACTION_HOSTILE)
-		{
-			controlTotal++;
-		}
-	}
-	
-	return controlTotal;
+	updateKillTotals();
+	return _totals.controls;
 }
 
 /**
@@ -972,24 +1007,8 @@ int SoldierDiary::getTrapKillTotal(Mod *mod) const
  */
 int SoldierDiary::getTerrorMissionTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	/// Not a UFO, not the base, not the alien base or colony
-	int terrorMissionTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				if ((*i)->success && !(*i)->isBaseDefense() && !(*i)->isUfoMission() && !(*i)->isAlienBase())
-				{
-					terrorMissionTotal++;
-				}
-			}
-		}
-	}
-	
-	return terrorMissionTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.terrorMissions;
 }
 
 /**
@@ -998,23 +1017,8 @@ int SoldierDiary::getTerrorMissionTotal(std::vector<MissionStatistics*> *mission
  */
 int SoldierDiary::getNightMissionTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int nightMissionTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				if ((*i)->success && (*i)->daylight > 5 && !(*i)->isBaseDefense() && !(*i)->isAlienBase())
-				{
-					nightMissionTotal++;
-				}
-			}
-		}
-	}
-	
-	return nightMissionTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.nightMissions;
 }
 
 /**
@@ -1023,23 +1027,8 @@ int SoldierDiary::getNightMissionTotal(std::vector<MissionStatistics*> *missionS
  */
 int SoldierDiary::getNightTerrorMissionTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int nightTerrorMissionTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				if ((*i)->success && (*i)->daylight > 5 && !(*i)->isBaseDefense() && !(*i)->isUfoMission() && !(*i)->isAlienBase())
-				{
-					nightTerrorMissionTotal++;
-				}
-			}
-		}
-	}
-	
-	return nightTerrorMissionTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.nightTerrorMissions;
 }
 
 /**
@@ -1048,23 +1037,8 @@ int SoldierDiary::getNightTerrorMissionTotal(std::vector<MissionStatistics*> *mi
  */
 int SoldierDiary::getBaseDefenseMissionTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int baseDefenseMissionTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				if ((*i)->success && (*i)->isBaseDefense())
-				{
-					baseDefenseMissionTotal++;
-				}
-			}
-		}
-	}
-	
-	return baseDefenseMissionTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.baseDefenseMissions;
 }
 
 /**
@@ -1073,23 +1047,8 @@ int SoldierDiary::getBaseDefenseMissionTotal(std::vector<MissionStatistics*> *mi
  */
 int SoldierDiary::getAlienBaseAssaultTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int alienBaseAssaultTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				if ((*i)->success && (*i)->isAlienBase())
-				{
-					alienBaseAssaultTotal++;
-				}
-			}
-		}
-	}
-	
-	return alienBaseAssaultTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.alienBaseAssaults;
 }
 
 /**
@@ -1098,23 +1057,8 @@ int SoldierDiary::getAlienBaseAssaultTotal(std::vector<MissionStatistics*> *miss
  */
 int SoldierDiary::getImportantMissionTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int importantMissionTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				if ((*i)->success && (*i)->type != "STR_UFO_CRASH_RECOVERY")
-				{
-					importantMissionTotal++;
-				}
-			}
-		}
-	}
-	
-	return importantMissionTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.importantMissions;
 }
 
 /**
@@ -1123,20 +1067,8 @@ int SoldierDiary::getImportantMissionTotal(std::vector<MissionStatistics*> *miss
  */
 int SoldierDiary::getScoreTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int scoreTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				scoreTotal += (*i)->score;
-			}
-		}
-	}
-	
-	return scoreTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.score;
 }
 
 /**
@@ -1145,20 +1077,8 @@ int SoldierDiary::getScoreTotal(std::vector<MissionStatistics*> *missionStatisti
  */
 int SoldierDiary::getValiantCruxTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int valiantCruxTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id && (*i)->valiantCrux)
-			{
-				valiantCruxTotal++;
-			}
-		}
-	}
-	
-	return valiantCruxTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.valiantCrux;
 }
 
 /**
@@ -1167,20 +1087,8 @@ int SoldierDiary::getValiantCruxTotal(std::vector<MissionStatistics*> *missionSt
  */
 int SoldierDiary::getLootValueTotal(std::vector<MissionStatistics*> *missionStatistics) const
 {
-	int lootValueTotal = 0;
-	
-	for (std::vector<MissionStatistics*>::const_iterator i = missionStatistics->begin(); i != missionStatistics->end(); ++i)
-	{
-		for (std::vector<int>::const_iterator j = _missionIdList.begin(); j != _missionIdList.end(); ++j)
-		{
-			if ((*j) == (*i)->id)
-			{
-				lootValueTotal += (*i)->lootValue;
-			}
-		}
-	}
-	
-	return lootValueTotal;
+	updateMissionTotals(missionStatistics);
+	return _totals.lootValue;
 }
 
 /**
@@ -28,6 +28,26 @@ namespace OpenXcom
 class Mod;
 struct BattleUnitKills;
 
+/**
+ * Running totals of a soldier's kills and missions,
+ * so commendations can be checked without rescanning
+ * the whole service history every time.
+ */
+struct SoldierDiaryTotals
+{
+	std::map<std::string, int> rank, race, weapon, weaponAmmo;
+	std::map<std::string, int> region, country, type, ufo;
+	int kills, stuns, panicks, controls;
+	int wins, score, terrorMissions, nightMissions, nightTerrorMissions, baseDefenseMissions, alienBaseAssaults, importantMissions, valiantCrux, lootValue;
+	bool killsValid, missionsValid;
+
+	SoldierDiaryTotals() : kills(0), stuns(0), panicks(0), controls(0),
+		wins(0), score(0), terrorMissions(0), nightMissions(0), nightTerrorMissions(0), baseDefenseMissions(0), alienBaseAssaults(0), importantMissions(0), valiantCrux(0), lootValue(0),
+		killsValid(false), missionsValid(false)
+	{
+	}
+};
+
 /**
  * Each entry will be its own commendation.
  */
@@ -79,6 +99,15 @@ private:
 		_woundsHealedTotal, _allUFOs, _allMissionTypes, _statGainTotal, _revivedUnitTotal, _wholeMedikitTotal, _braveryGainTotal, _bestOfRank, _MIA,
 		_martyrKillsTotal, _postMortemKills, _slaveKillsTotal, _bestSoldier;
 	bool _globeTrotter;
+	mutable SoldierDiaryTotals _totals;
+	/// Adds a kill to the running totals.
+	void addKillTotals(const BattleUnitKills *kill) const;
+	/// Adds a mission to the running totals.
+	void addMissionTotals(const MissionStatistics *mission) const;
+	/// Builds the kill totals if they aren't up to date.
+	void updateKillTotals() const;
+	/// Builds the mission totals if they aren't up to date.
+	void updateMissionTotals(std::vector<MissionStatistics*> *missionStatistics) const;
 	void manageModularCommendations(std::map<std::string, int> &nextCommendationLevel, std::map<std::string, int> &modularCommendations, std::pair<std::string, int> statTotal, int criteria);
 	void awardCommendation(const std::string& type, const std::string& noun = "noNoun");
 public:
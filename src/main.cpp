@@ -23,6 +23,8 @@
 #include "Engine/Game.h"
 #include "Engine/Options.h"
 #include "Menu/StartState.h"
+#include "Geoscape/GeoscapeBenchmark.h"
+#include "Battlescape/BattlescapeBenchmark.h"
 
 /** @mainpage
  * @author OpenXcom Developers
@@ -115,8 +117,48 @@ int main(int argc, char *argv[])
 	Options::baseXResolution = Options::displayWidth;
 	Options::baseYResolution = Options::displayHeight;
 
+	bool benchmark = !Options::benchmarkSave.empty() || !Options::benchmarkBattle.empty();
+	if (benchmark)
+	{
+		// no window or sound needed to benchmark
+		SDL_putenv(const_cast<char*>("SDL_VIDEODRIVER=dummy"));
+		SDL_putenv(const_cast<char*>("SDL_AUDIODRIVER=dummy"));
+	}
+
 	game = new Game(title.str());
 	State::setGamePtr(game);
+	if (benchmark)
+	{
+		int result = EXIT_SUCCESS;
+		try
+		{
+			if (!Options::benchmarkBattle.empty())
+			{
+				BattlescapeBenchmark benchmark(game);
+				benchmark.load(Options::benchmarkBattle);
+				benchmark.run(10);
+				benchmark.report();
+				if (!Options::benchmarkOutput.empty())
+					benchmark.save(Options::benchmarkOutput);
+			}
+			else
+			{
+				GeoscapeBenchmark benchmark(game);
+				benchmark.load(Options::benchmarkSave);
+				benchmark.run(Options::benchmarkDays > 0 ? Options::benchmarkDays : 30);
+				benchmark.report();
+				if (!Options::benchmarkOutput.empty())
+					benchmark.save(Options::benchmarkOutput);
+			}
+		}
+		catch (std::exception &e)
+		{
+			Log(LOG_ERROR) << e.what();
+			result = EXIT_FAILURE;
+		}
+		delete game;
+		return result;
+	}
 	game->setState(new StartState);
 	game->run();
 